@@ -1,16 +1,44 @@
+import os
 from pathlib import Path
 from setuptools import Extension, setup
 
-ROOT = Path(__file__).resolve().parents[1]
+ROOT = Path(__file__).resolve().parents[2]
 
-sources = [
-    "src/ct_resume_hash/_native.c",
-    str(ROOT / "src" / "ct_resume_hash.c"),
-    str(ROOT / "src" / "normalize_ref.c"),
-    str(ROOT / "src" / "normalize_ct.c"),
-    str(ROOT / "src" / "hash_core.c"),
-    str(ROOT / "src" / "sha256.c"),
-]
+# Link the optimized static library (LTO + per-ISA clones) from the CMake
+# release-lto preset when it has been built; point CT_RESUME_HASH_LIB_DIR at
+# another build dir (e.g. build/pgo-use) to use that archive instead. Without
+# an archive the C sources are recompiled with the flags below, which is the
+# unoptimized fallback (plain -O2, no LTO, clones or PGO).
+DEFAULT_LIB_DIR = ROOT / "build" / "release-lto"
+LIB_DIR = os.environ.get("CT_RESUME_HASH_LIB_DIR")
+
+sources = ["src/ct_resume_hash/_native.c"]
+extra_objects = []
+
+if LIB_DIR:
+    archive = Path(LIB_DIR).resolve() / "libct_resume_hash.a"
+    if not archive.is_file():
+        raise RuntimeError(f"CT_RESUME_HASH_LIB_DIR: {archive} not found")
+else:
+    archive = DEFAULT_LIB_DIR / "libct_resume_hash.a"
+    if not archive.is_file():
+        archive = None
+
+if archive:
+    extra_objects.append(str(archive))
+else:
+    sources += [
+        str(ROOT / "src" / "ct_resume_hash.c"),
+        str(ROOT / "src" / "normalize_ref.c"),
+        str(ROOT / "src" / "normalize_ct.c"),
+        str(ROOT / "src" / "hash_core.c"),
+        str(ROOT / "src" / "sha256.c"),
+        str(ROOT / "src" / "cache.c"),
+        str(ROOT / "src" / "pool.c"),
+        str(ROOT / "src" / "digest_codec.c"),
+        str(ROOT / "src" / "digest_simd_x86.c"),
+        str(ROOT / "src" / "digest_simd_neon.c"),
+    ]
 
 ext_modules = [
     Extension(
@@ -19,8 +47,8 @@ ext_modules = [
         include_dirs=[str(ROOT / "include"), str(ROOT / "src")],
         define_macros=[("CT_RESUME_HASH_USE_CT", "1")],
         extra_compile_args=["-O2", "-fwrapv", "-fno-builtin-memcmp"],
+        extra_objects=extra_objects,
     )
 ]
 
 setup(ext_modules=ext_modules)
-
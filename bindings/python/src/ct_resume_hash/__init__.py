@@ -1,2 +1,12 @@
-from ._native import hash_once  # noqa: F401
-
+from ._async import configure_async, hash_async  # noqa: F401
+from ._digest import decode_digest, decode_digests, encode_digest, encode_digests  # noqa: F401
+from ._native import (  # noqa: F401
+    cache_disable,
+    cache_enable,
+    cache_stats,
+    digest_equal,
+    find_digest,
+    hash_once,
+    match_digests,
+    truncate_digests,
+)
@@ -0,0 +1,81 @@
+"""asyncio integration: hash on a native worker pool without blocking the loop."""
+
+import asyncio
+import itertools
+import os
+import weakref
+
+from ._native import Pool, hash_once
+
+# Inputs up to this many bytes are hashed inline; handing them to a worker
+# costs more than hashing them.
+DEFAULT_INLINE_MAX = 16 * 1024
+
+_config = {
+    "workers": min(4, os.cpu_count() or 1),
+    "inline_max": DEFAULT_INLINE_MAX,
+}
+_dispatchers = weakref.WeakKeyDictionary()
+
+
+class _Dispatcher:
+    """One native pool per event loop; completions are drained by a fd reader."""
+
+    def __init__(self, loop, workers, inline_max):
+        self._pool = Pool(workers, inline_max)
+        self._pending = {}
+        self._tags = itertools.count()
+        loop.add_reader(self._pool.fileno(), self._drain)
+
+    def submit(self, loop, text):
+        fut = loop.create_future()
+        tag = next(self._tags)
+        digest = self._pool.submit(text, tag)
+        if digest is not None:
+            fut.set_result(digest)
+        else:
+            self._pending[tag] = fut
+        return fut
+
+    def _drain(self):
+        for tag, digest in self._pool.poll():
+            fut = self._pending.pop(tag, None)
+            if fut is None or fut.done():
+                continue
+            if digest is None:
+                fut.set_exception(RuntimeError("ct_resume_hash_once failed"))
+            else:
+                fut.set_result(digest)
+
+
+def configure_async(workers=None, inline_max=None):
+    """Set pool size and inline threshold (bytes) for loops that have not hashed yet."""
+    if workers is not None:
+        if workers <= 0:
+            raise ValueError("workers must be positive")
+        _config["workers"] = workers
+    if inline_max is not None:
+        if inline_max < 0:
+            raise ValueError("inline_max must be non-negative")
+        _config["inline_max"] = inline_max
+
+
+def _dispatcher_for(loop):
+    dispatcher = _dispatchers.get(loop)
+    if dispatcher is None:
+        dispatcher = _Dispatcher(loop, _config["workers"], _config["inline_max"])
+        _dispatchers[loop] = dispatcher
+    return dispatcher
+
+
+async def hash_async(text):
+    """Awaitable ``hash_once``: large inputs run on the native pool."""
+    loop = asyncio.get_running_loop()
+    if len(text) <= _config["inline_max"] and text.isascii():
+        return hash_once(text)
+    try:
+        dispatcher = _dispatcher_for(loop)
+    except NotImplementedError:
+        # Loops without add_reader (e.g. Windows proactor) fall back to threads.
+        return await loop.run_in_executor(None, hash_once, text)
+    return await dispatcher.submit(loop, text)
@@ -0,0 +1,46 @@
+"""Digest encodings on top of the native table-free codecs."""
+
+from ._native import _decode, _encode
+
+DIGEST_LEN = 32
+
+# Matches ct_digest_encoding in ct_resume_hash.h.
+_ENCODINGS = {"hex": (0, 64), "base32": (1, 52), "base64url": (2, 43)}
+
+
+def _lookup(encoding):
+    try:
+        return _ENCODINGS[encoding]
+    except KeyError:
+        raise ValueError(f"unknown digest encoding {encoding!r}") from None
+
+
+def encode_digest(digest, encoding="hex"):
+    """32-byte digest -> str (hex, lowercase base32 or base64url; unpadded)."""
+    if len(digest) != DIGEST_LEN:
+        raise ValueError("digest must be 32 bytes")
+    return _encode(digest, _lookup(encoding)[0])
+
+
+def encode_digests(digests, encoding="hex"):
+    """Contiguous array of 32-byte digests -> list of str, encoded in one call."""
+    enc, width = _lookup(encoding)
+    text = _encode(digests, enc)
+    return [text[i:i + width] for i in range(0, len(text), width)]
+
+
+def decode_digest(text, encoding="hex"):
+    """Inverse of encode_digest; raises ValueError on malformed input."""
+    enc, width = _lookup(encoding)
+    if len(text) != width:
+        raise ValueError(f"{encoding} digest must be {width} characters")
+    return _decode(text, enc)
+
+
+def decode_digests(texts, encoding="hex"):
+    """Iterable of encoded digests -> contiguous bytes array."""
+    enc, width = _lookup(encoding)
+    texts = list(texts)
+    if any(len(t) != width for t in texts):
+        raise ValueError(f"{encoding} digests must be {width} characters")
+    return _decode("".join(texts), enc)
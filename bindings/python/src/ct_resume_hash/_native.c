@@ -12,8 +12,14 @@ static PyObject *py_ct_resume_hash_once(PyObject *self, PyObject *args) {
         return NULL;
     }
 
+    // `input` points into the str's UTF-8 buffer, kept alive by `args`;
+    // release the GIL so executor threads can hash in parallel.
     uint8_t out[CT_RESUME_HASH_LEN];
-    if (ct_resume_hash_once((const uint8_t *)input, (size_t)input_len, out) != 0) {
+    int rc;
+    Py_BEGIN_ALLOW_THREADS
+    rc = ct_resume_hash_once((const uint8_t *)input, (size_t)input_len, out);
+    Py_END_ALLOW_THREADS
+    if (rc != 0) {
         PyErr_SetString(PyExc_RuntimeError, "ct_resume_hash_once failed");
         return NULL;
     }
@@ -21,8 +27,367 @@ static PyObject *py_ct_resume_hash_once(PyObject *self, PyObject *args) {
     return PyBytes_FromStringAndSize((const char *)out, CT_RESUME_HASH_LEN);
 }
 
+static PyObject *py_ct_resume_hash_cache_enable(PyObject *self, PyObject *args) {
+    Py_ssize_t max_bytes = 0;
+
+    if (!PyArg_ParseTuple(args, "n", &max_bytes)) {
+        return NULL;
+    }
+    if (max_bytes <= 0 || ct_resume_hash_cache_enable((size_t)max_bytes) != 0) {
+        PyErr_Format(PyExc_ValueError, "max_bytes must be at least %zu",
+                     (size_t)CT_RESUME_HASH_CACHE_MIN_BYTES);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *py_ct_resume_hash_cache_disable(PyObject *self, PyObject *args) {
+    ct_resume_hash_cache_disable();
+    Py_RETURN_NONE;
+}
+
+static PyObject *py_ct_resume_hash_cache_stats(PyObject *self, PyObject *args) {
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+
+    return Py_BuildValue("{s:K,s:K,s:K,s:K,s:n,s:n,s:n}",
+                         "hits", (unsigned long long)stats.hits,
+                         "misses", (unsigned long long)stats.misses,
+                         "insertions", (unsigned long long)stats.insertions,
+                         "evictions", (unsigned long long)stats.evictions,
+                         "entries", (Py_ssize_t)stats.entries,
+                         "bytes", (Py_ssize_t)stats.bytes,
+                         "max_bytes", (Py_ssize_t)stats.max_bytes);
+}
+
+typedef struct {
+    PyObject_HEAD
+    ct_resume_hash_pool *pool;
+} PoolObject;
+
+static int Pool_init(PoolObject *self, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"workers", "inline_max", NULL};
+    Py_ssize_t workers = 0;
+    Py_ssize_t inline_max = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "nn", kwlist, &workers, &inline_max)) {
+        return -1;
+    }
+    if (workers <= 0 || inline_max < 0) {
+        PyErr_SetString(PyExc_ValueError, "workers must be positive and inline_max non-negative");
+        return -1;
+    }
+    if (self->pool) {
+        ct_resume_hash_pool_free(self->pool);
+    }
+    self->pool = ct_resume_hash_pool_new((size_t)workers, (size_t)inline_max);
+    if (!self->pool) {
+        PyErr_SetString(PyExc_RuntimeError, "ct_resume_hash_pool_new failed");
+        return -1;
+    }
+    return 0;
+}
+
+static void Pool_close_pool(PoolObject *self) {
+    if (self->pool) {
+        // Joins workers; release the GIL so in-flight jobs can finish.
+        ct_resume_hash_pool *pool = self->pool;
+        self->pool = NULL;
+        Py_BEGIN_ALLOW_THREADS
+        ct_resume_hash_pool_free(pool);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+static void Pool_dealloc(PoolObject *self) {
+    Pool_close_pool(self);
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int Pool_check_open(PoolObject *self) {
+    if (!self->pool) {
+        PyErr_SetString(PyExc_ValueError, "pool is closed");
+        return -1;
+    }
+    return 0;
+}
+
+static PyObject *Pool_submit(PoolObject *self, PyObject *args) {
+    const char *input = NULL;
+    Py_ssize_t input_len = 0;
+    unsigned long long tag = 0;
+
+    if (!PyArg_ParseTuple(args, "s#K", &input, &input_len, &tag)) {
+        return NULL;
+    }
+    if (Pool_check_open(self) != 0) {
+        return NULL;
+    }
+
+    uint8_t out[CT_RESUME_HASH_LEN];
+    int rc = ct_resume_hash_pool_submit(self->pool, (const uint8_t *)input,
+                                        (size_t)input_len, (uint64_t)tag, out);
+    if (rc == 1) {
+        return PyBytes_FromStringAndSize((const char *)out, CT_RESUME_HASH_LEN);
+    }
+    if (rc != 0) {
+        PyErr_SetString(PyExc_RuntimeError, "ct_resume_hash_pool_submit failed");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject *Pool_fileno(PoolObject *self, PyObject *args) {
+    if (Pool_check_open(self) != 0) {
+        return NULL;
+    }
+    return PyLong_FromLong(ct_resume_hash_pool_fd(self->pool));
+}
+
+static PyObject *Pool_poll(PoolObject *self, PyObject *args) {
+    if (Pool_check_open(self) != 0) {
+        return NULL;
+    }
+
+    PyObject *list = PyList_New(0);
+    if (!list) {
+        return NULL;
+    }
+
+    ct_resume_hash_completion batch[32];
+    size_t n;
+    while ((n = ct_resume_hash_pool_poll(self->pool, batch, 32)) > 0) {
+        for (size_t i = 0; i < n; i++) {
+            PyObject *item;
+            if (batch[i].rc == 0) {
+                item = Py_BuildValue("(Ky#)", (unsigned long long)batch[i].tag,
+                                     (const char *)batch[i].digest, (Py_ssize_t)CT_RESUME_HASH_LEN);
+            } else {
+                item = Py_BuildValue("(KO)", (unsigned long long)batch[i].tag, Py_None);
+            }
+            if (!item || PyList_Append(list, item) != 0) {
+                Py_XDECREF(item);
+                Py_DECREF(list);
+                return NULL;
+            }
+            Py_DECREF(item);
+        }
+        if (n < 32) {
+            break;
+        }
+    }
+    return list;
+}
+
+static PyObject *Pool_close(PoolObject *self, PyObject *args) {
+    Pool_close_pool(self);
+    Py_RETURN_NONE;
+}
+
+static PyMethodDef Pool_methods[] = {
+    {"submit", (PyCFunction)Pool_submit, METH_VARARGS,
+     "submit(text, tag) -> digest if hashed inline, else None (result arrives via poll)"},
+    {"fileno", (PyCFunction)Pool_fileno, METH_NOARGS, "Completion fd for event-loop readers"},
+    {"poll", (PyCFunction)Pool_poll, METH_NOARGS,
+     "Drain completions as a list of (tag, digest or None on failure)"},
+    {"close", (PyCFunction)Pool_close, METH_NOARGS, "Finish queued jobs and release the pool"},
+    {NULL, NULL, 0, NULL}
+};
+
+static PyTypeObject PoolType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "ct_resume_hash._native.Pool",
+    .tp_basicsize = sizeof(PoolObject),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Pool(workers, inline_max): worker pool with a pollable completion queue",
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Pool_init,
+    .tp_dealloc = (destructor)Pool_dealloc,
+    .tp_methods = Pool_methods,
+};
+
+static int digest_array_len(const Py_buffer *buf, size_t *n) {
+    if (buf->len % CT_RESUME_HASH_LEN != 0) {
+        PyErr_SetString(PyExc_ValueError, "length must be a multiple of CT_RESUME_HASH_LEN (32)");
+        return -1;
+    }
+    *n = (size_t)buf->len / CT_RESUME_HASH_LEN;
+    return 0;
+}
+
+static int parse_encoding(int enc, size_t *per_digest) {
+    if (enc < CT_DIGEST_HEX || enc > CT_DIGEST_BASE64URL) {
+        PyErr_SetString(PyExc_ValueError, "unknown digest encoding");
+        return -1;
+    }
+    *per_digest = ct_digest_encoded_len((ct_digest_encoding)enc);
+    return 0;
+}
+
+static PyObject *py_ct_digest_encode(PyObject *self, PyObject *args) {
+    Py_buffer buf;
+    int enc = 0;
+    size_t n = 0;
+    size_t per_digest = 0;
+
+    if (!PyArg_ParseTuple(args, "y*i", &buf, &enc)) {
+        return NULL;
+    }
+    if (digest_array_len(&buf, &n) != 0 || parse_encoding(enc, &per_digest) != 0) {
+        PyBuffer_Release(&buf);
+        return NULL;
+    }
+
+    // Encode straight into the storage of an ASCII str.
+    PyObject *text = PyUnicode_New((Py_ssize_t)(n * per_digest), 127);
+    if (text) {
+        ct_digest_encode((ct_digest_encoding)enc, (const uint8_t *)buf.buf, n,
+                         (char *)PyUnicode_1BYTE_DATA(text));
+    }
+    PyBuffer_Release(&buf);
+    return text;
+}
+
+static PyObject *py_ct_digest_decode(PyObject *self, PyObject *args) {
+    const char *text = NULL;
+    Py_ssize_t text_len = 0;
+    int enc = 0;
+    size_t per_digest = 0;
+
+    if (!PyArg_ParseTuple(args, "s#i", &text, &text_len, &enc)) {
+        return NULL;
+    }
+    if (parse_encoding(enc, &per_digest) != 0) {
+        return NULL;
+    }
+    if ((size_t)text_len % per_digest != 0) {
+        PyErr_SetString(PyExc_ValueError, "encoded length does not match the encoding");
+        return NULL;
+    }
+    size_t n = (size_t)text_len / per_digest;
+
+    PyObject *out = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(n * CT_RESUME_HASH_LEN));
+    if (!out) {
+        return NULL;
+    }
+    if (ct_digest_decode((ct_digest_encoding)enc, text, n, (uint8_t *)PyBytes_AS_STRING(out)) != 0) {
+        Py_DECREF(out);
+        PyErr_SetString(PyExc_ValueError, "invalid encoded digest");
+        return NULL;
+    }
+    return out;
+}
+
+static int parse_needle_haystack(PyObject *args, Py_buffer *needle, Py_buffer *haystack, size_t *n) {
+    if (!PyArg_ParseTuple(args, "y*y*", needle, haystack)) {
+        return -1;
+    }
+    if (needle->len != CT_RESUME_HASH_LEN) {
+        PyErr_SetString(PyExc_ValueError, "needle must be 32 bytes");
+    } else if (digest_array_len(haystack, n) == 0) {
+        return 0;
+    }
+    PyBuffer_Release(needle);
+    PyBuffer_Release(haystack);
+    return -1;
+}
+
+static PyObject *py_ct_digest_equal(PyObject *self, PyObject *args) {
+    Py_buffer a;
+    Py_buffer b;
+    size_t n = 0;
+
+    if (parse_needle_haystack(args, &a, &b, &n) != 0) {
+        return NULL;
+    }
+    int eq = n == 1 && ct_digest_equal((const uint8_t *)a.buf, (const uint8_t *)b.buf);
+    PyBuffer_Release(&a);
+    PyBuffer_Release(&b);
+    if (n != 1) {
+        PyErr_SetString(PyExc_ValueError, "digests must be 32 bytes");
+        return NULL;
+    }
+    return PyBool_FromLong(eq);
+}
+
+static PyObject *py_ct_digest_find(PyObject *self, PyObject *args) {
+    Py_buffer needle;
+    Py_buffer haystack;
+    size_t n = 0;
+
+    if (parse_needle_haystack(args, &needle, &haystack, &n) != 0) {
+        return NULL;
+    }
+    size_t idx;
+    Py_BEGIN_ALLOW_THREADS
+    idx = ct_digest_find((const uint8_t *)needle.buf, (const uint8_t *)haystack.buf, n);
+    Py_END_ALLOW_THREADS
+    PyBuffer_Release(&needle);
+    PyBuffer_Release(&haystack);
+    return PyLong_FromSsize_t(idx == n ? -1 : (Py_ssize_t)idx);
+}
+
+static PyObject *py_ct_digest_match(PyObject *self, PyObject *args) {
+    Py_buffer needle;
+    Py_buffer haystack;
+    size_t n = 0;
+
+    if (parse_needle_haystack(args, &needle, &haystack, &n) != 0) {
+        return NULL;
+    }
+    PyObject *out = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)n);
+    if (out) {
+        uint8_t *eq = (uint8_t *)PyBytes_AS_STRING(out);
+        Py_BEGIN_ALLOW_THREADS
+        ct_digest_equal_batch((const uint8_t *)needle.buf, (const uint8_t *)haystack.buf, n, eq);
+        Py_END_ALLOW_THREADS
+    }
+    PyBuffer_Release(&needle);
+    PyBuffer_Release(&haystack);
+    return out;
+}
+
+static PyObject *py_ct_digest_truncate(PyObject *self, PyObject *args) {
+    Py_buffer buf;
+    Py_ssize_t short_len = 0;
+    size_t n = 0;
+
+    if (!PyArg_ParseTuple(args, "y*n", &buf, &short_len)) {
+        return NULL;
+    }
+    if (digest_array_len(&buf, &n) != 0) {
+        PyBuffer_Release(&buf);
+        return NULL;
+    }
+    if (short_len != CT_DIGEST_SHORT64_LEN && short_len != CT_DIGEST_SHORT128_LEN) {
+        PyBuffer_Release(&buf);
+        PyErr_SetString(PyExc_ValueError, "length must be 8 or 16");
+        return NULL;
+    }
+    PyObject *out = PyBytes_FromStringAndSize(NULL, (Py_ssize_t)(n * (size_t)short_len));
+    if (out) {
+        ct_digest_truncate((const uint8_t *)buf.buf, n, (size_t)short_len,
+                           (uint8_t *)PyBytes_AS_STRING(out));
+    }
+    PyBuffer_Release(&buf);
+    return out;
+}
+
 static PyMethodDef Methods[] = {
     {"hash_once", py_ct_resume_hash_once, METH_VARARGS, "Hash resume text"},
+    {"cache_enable", py_ct_resume_hash_cache_enable, METH_VARARGS, "Enable the memo cache with a byte budget"},
+    {"cache_disable", py_ct_resume_hash_cache_disable, METH_NOARGS, "Disable and clear the memo cache"},
+    {"cache_stats", py_ct_resume_hash_cache_stats, METH_NOARGS, "Memo cache counters as a dict"},
+    {"_encode", py_ct_digest_encode, METH_VARARGS, "Encode concatenated digests into one str"},
+    {"_decode", py_ct_digest_decode, METH_VARARGS, "Decode concatenated encoded digests into bytes"},
+    {"digest_equal", py_ct_digest_equal, METH_VARARGS, "Constant-time equality of two 32-byte digests"},
+    {"find_digest", py_ct_digest_find, METH_VARARGS,
+     "Index of the first match of needle in a contiguous digest array, or -1 (full scan)"},
+    {"match_digests", py_ct_digest_match, METH_VARARGS,
+     "bytes with 1 where the digest array equals needle, else 0"},
+    {"truncate_digests", py_ct_digest_truncate, METH_VARARGS,
+     "Leading 8 or 16 bytes of each digest, concatenated"},
     {NULL, NULL, 0, NULL}
 };
 
@@ -35,6 +400,21 @@ static struct PyModuleDef moduledef = {
 };
 
 PyMODINIT_FUNC PyInit__native(void) {
-    return PyModule_Create(&moduledef);
+    if (PyType_Ready(&PoolType) < 0) {
+        return NULL;
+    }
+
+    PyObject *module = PyModule_Create(&moduledef);
+    if (!module) {
+        return NULL;
+    }
+
+    Py_INCREF(&PoolType);
+    if (PyModule_AddObject(module, "Pool", (PyObject *)&PoolType) < 0) {
+        Py_DECREF(&PoolType);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
 }
 
@@ -1,3 +1,4 @@
+use std::env;
 use std::path::PathBuf;
 
 fn main() {
@@ -8,16 +9,48 @@ fn main() {
         .expect("repo root")
         .to_path_buf();
 
+    // Link the optimized static library (LTO + per-ISA clones) from the CMake
+    // release-lto preset when it has been built; CT_RESUME_HASH_LIB_DIR picks
+    // another build dir (e.g. build/pgo-use). Without an archive the C sources
+    // are compiled below, which is the unoptimized fallback.
+    println!("cargo:rerun-if-env-changed=CT_RESUME_HASH_LIB_DIR");
+    let archive = match env::var("CT_RESUME_HASH_LIB_DIR") {
+        Ok(lib_dir) if !lib_dir.is_empty() => {
+            let archive = PathBuf::from(lib_dir).join("libct_resume_hash.a");
+            assert!(
+                archive.is_file(),
+                "CT_RESUME_HASH_LIB_DIR: {} not found",
+                archive.display()
+            );
+            Some(archive)
+        }
+        _ => Some(root.join("build/release-lto/libct_resume_hash.a")).filter(|a| a.is_file()),
+    };
+    if let Some(archive) = archive {
+        let lib_dir = archive.parent().expect("archive dir");
+        // Relink when the CMake build refreshes the archive.
+        println!("cargo:rerun-if-changed={}", archive.display());
+        println!("cargo:rustc-link-search=native={}", lib_dir.display());
+        println!("cargo:rustc-link-lib=static=ct_resume_hash");
+        return;
+    }
+
     let mut build = cc::Build::new();
     build
         .define("CT_RESUME_HASH_USE_CT", None)
         .include(root.join("include"))
+        .flag("-fwrapv")
+        .flag("-fno-builtin-memcmp")
         .file(root.join("src/ct_resume_hash.c"))
         .file(root.join("src/normalize_ref.c"))
         .file(root.join("src/normalize_ct.c"))
         .file(root.join("src/hash_core.c"))
-        .file(root.join("src/sha256.c"));
+        .file(root.join("src/sha256.c"))
+        .file(root.join("src/cache.c"))
+        .file(root.join("src/pool.c"))
+        .file(root.join("src/digest_codec.c"))
+        .file(root.join("src/digest_simd_x86.c"))
+        .file(root.join("src/digest_simd_neon.c"));
 
     build.compile("ct_resume_hash");
 }
-
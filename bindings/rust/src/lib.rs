@@ -1,4 +1,11 @@
-use std::os::raw::{c_int, c_uchar};
+use std::collections::HashMap;
+use std::future::Future;
+use std::os::raw::{c_int, c_uchar, c_void};
+use std::pin::Pin;
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering};
+use std::sync::{Arc, Mutex};
+use std::task::{Context, Poll, Waker};
+use std::thread::JoinHandle;
 
 pub const CT_RESUME_HASH_LEN: usize = 32;
 
@@ -22,3 +29,611 @@ pub fn hash_once(input: &str) -> Result<[u8; CT_RESUME_HASH_LEN], &'static str>
     }
 }
 
+
+#[repr(C)]
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+pub struct CacheStats {
+    pub hits: u64,
+    pub misses: u64,
+    pub insertions: u64,
+    pub evictions: u64,
+    pub entries: usize,
+    pub bytes: usize,
+    pub max_bytes: usize,
+}
+
+extern "C" {
+    fn ct_resume_hash_cache_enable(max_bytes: usize) -> c_int;
+    fn ct_resume_hash_cache_disable();
+    fn ct_resume_hash_cache_get_stats(out: *mut CacheStats);
+}
+
+/// Enable the process-wide memo cache. Repeated inputs are served from the
+/// cache and no longer take the constant-time path. `max_bytes` must be at
+/// least 64 KiB; it is split across 16 shards, and an input larger than one
+/// shard's slice is never cached.
+pub fn cache_enable(max_bytes: usize) -> Result<(), &'static str> {
+    let rc = unsafe { ct_resume_hash_cache_enable(max_bytes) };
+    if rc == 0 {
+        Ok(())
+    } else {
+        Err("ct_resume_hash_cache_enable failed")
+    }
+}
+
+pub fn cache_disable() {
+    unsafe { ct_resume_hash_cache_disable() }
+}
+
+pub fn cache_stats() -> CacheStats {
+    let mut stats = CacheStats::default();
+    unsafe { ct_resume_hash_cache_get_stats(&mut stats) };
+    stats
+}
+
+#[repr(C)]
+struct Completion {
+    tag: u64,
+    rc: c_int,
+    digest: [u8; CT_RESUME_HASH_LEN],
+}
+
+extern "C" {
+    fn ct_resume_hash_pool_new(n_workers: usize, inline_max: usize) -> *mut c_void;
+    fn ct_resume_hash_pool_free(pool: *mut c_void);
+    fn ct_resume_hash_pool_submit(
+        pool: *mut c_void,
+        input: *const c_uchar,
+        input_len: usize,
+        tag: u64,
+        inline_out: *mut c_uchar,
+    ) -> c_int;
+    fn ct_resume_hash_pool_wait(
+        pool: *mut c_void,
+        out: *mut Completion,
+        max: usize,
+        timeout_ms: c_int,
+    ) -> usize;
+}
+
+type HashResult = Result<[u8; CT_RESUME_HASH_LEN], &'static str>;
+
+// Completion tag queued by `Pool::drop` to wake the reactor; real tags count
+// up from 0 and never reach it.
+const SHUTDOWN_TAG: u64 = u64::MAX;
+
+// The C pool is internally synchronized; submit and wait are thread-safe.
+#[derive(Clone, Copy)]
+struct RawPool(*mut c_void);
+unsafe impl Send for RawPool {}
+unsafe impl Sync for RawPool {}
+
+enum Slot {
+    Waiting(Option<Waker>),
+    Done(HashResult),
+}
+
+struct Shared {
+    slots: Mutex<HashMap<u64, Slot>>,
+    shutdown: AtomicBool,
+}
+
+/// Worker pool behind `hash_async`. Inputs up to `inline_max` bytes are
+/// hashed on the calling thread; larger ones run on `workers` C threads and
+/// complete through a reactor thread that wakes the returned futures, so any
+/// executor (tokio, async-std, a hand-rolled one) can await them.
+pub struct Pool {
+    raw: RawPool,
+    shared: Arc<Shared>,
+    next_tag: AtomicU64,
+    reactor: Option<JoinHandle<()>>,
+}
+
+impl Pool {
+    pub fn new(workers: usize, inline_max: usize) -> Result<Pool, &'static str> {
+        let raw = RawPool(unsafe { ct_resume_hash_pool_new(workers, inline_max) });
+        if raw.0.is_null() {
+            return Err("ct_resume_hash_pool_new failed");
+        }
+        let shared = Arc::new(Shared {
+            slots: Mutex::new(HashMap::new()),
+            shutdown: AtomicBool::new(false),
+        });
+        let reactor_shared = Arc::clone(&shared);
+        let reactor = std::thread::Builder::new()
+            .name("ct-resume-hash-reactor".into())
+            .spawn(move || reactor_main(raw, reactor_shared))
+            .map_err(|_| {
+                unsafe { ct_resume_hash_pool_free(raw.0) };
+                "failed to spawn reactor thread"
+            })?;
+        Ok(Pool {
+            raw,
+            shared,
+            next_tag: AtomicU64::new(0),
+            reactor: Some(reactor),
+        })
+    }
+
+    /// Hash `input` without blocking the caller on large inputs.
+    pub fn hash_async(&self, input: &str) -> HashFuture {
+        let bytes = input.as_bytes();
+        let tag = self.next_tag.fetch_add(1, Ordering::Relaxed);
+        let mut out = [0u8; CT_RESUME_HASH_LEN];
+
+        // Register before submitting so the reactor always finds the slot.
+        self.shared
+            .slots
+            .lock()
+            .unwrap()
+            .insert(tag, Slot::Waiting(None));
+        let rc = unsafe {
+            ct_resume_hash_pool_submit(self.raw.0, bytes.as_ptr(), bytes.len(), tag, out.as_mut_ptr())
+        };
+        if rc != 0 {
+            self.shared.slots.lock().unwrap().remove(&tag);
+            let result = if rc == 1 {
+                Ok(out)
+            } else {
+                Err("ct_resume_hash_pool_submit failed")
+            };
+            return HashFuture {
+                state: FutureState::Ready(Some(result)),
+            };
+        }
+        HashFuture {
+            state: FutureState::Pending {
+                tag,
+                shared: Arc::clone(&self.shared),
+            },
+        }
+    }
+}
+
+impl Drop for Pool {
+    fn drop(&mut self) {
+        // The reactor blocks without a timeout, so queue a completion to wake
+        // it; it exits once every outstanding job has completed.
+        self.shared.shutdown.store(true, Ordering::Release);
+        let rc = unsafe {
+            ct_resume_hash_pool_submit(
+                self.raw.0,
+                b"".as_ptr(),
+                0,
+                SHUTDOWN_TAG,
+                std::ptr::null_mut(),
+            )
+        };
+        if rc != 0 {
+            // Out of memory: the reactor cannot be woken, so leak the pool
+            // rather than free it under a blocked thread.
+            return;
+        }
+        if let Some(reactor) = self.reactor.take() {
+            let _ = reactor.join();
+        }
+        unsafe { ct_resume_hash_pool_free(self.raw.0) };
+    }
+}
+
+fn reactor_main(raw: RawPool, shared: Arc<Shared>) {
+    let mut batch: Vec<Completion> = Vec::with_capacity(32);
+    loop {
+        // No timeout: an idle pool costs nothing, and Drop queues
+        // SHUTDOWN_TAG to wake this thread.
+        let n = unsafe { ct_resume_hash_pool_wait(raw.0, batch.as_mut_ptr(), 32, -1) };
+        unsafe { batch.set_len(n) };
+
+        let mut wake = Vec::new();
+        let exit = {
+            let mut slots = shared.slots.lock().unwrap();
+            for c in batch.drain(..) {
+                if let Some(slot) = slots.get_mut(&c.tag) {
+                    let result = if c.rc == 0 {
+                        Ok(c.digest)
+                    } else {
+                        Err("ct_resume_hash_once failed")
+                    };
+                    if let Slot::Waiting(waker) = std::mem::replace(slot, Slot::Done(result)) {
+                        wake.extend(waker);
+                    }
+                }
+            }
+            let idle = !slots.values().any(|s| matches!(s, Slot::Waiting(_)));
+            idle && shared.shutdown.load(Ordering::Acquire)
+        };
+        // Wake before exiting so the last batch is delivered too.
+        for waker in wake {
+            waker.wake();
+        }
+        if exit {
+            break;
+        }
+    }
+}
+
+enum FutureState {
+    Ready(Option<HashResult>),
+    Pending { tag: u64, shared: Arc<Shared> },
+}
+
+/// Future returned by [`Pool::hash_async`].
+pub struct HashFuture {
+    state: FutureState,
+}
+
+impl Future for HashFuture {
+    type Output = HashResult;
+
+    fn poll(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<HashResult> {
+        match &mut self.state {
+            FutureState::Ready(result) => {
+                Poll::Ready(result.take().expect("HashFuture polled after completion"))
+            }
+            FutureState::Pending { tag, shared } => {
+                let tag = *tag;
+                let mut slots = shared.slots.lock().unwrap();
+                match slots.remove(&tag) {
+                    Some(Slot::Done(result)) => {
+                        drop(slots);
+                        self.state = FutureState::Ready(None);
+                        Poll::Ready(result)
+                    }
+                    _ => {
+                        slots.insert(tag, Slot::Waiting(Some(cx.waker().clone())));
+                        Poll::Pending
+                    }
+                }
+            }
+        }
+    }
+}
+
+impl Drop for HashFuture {
+    fn drop(&mut self) {
+        if let FutureState::Pending { tag, shared } = &self.state {
+            if let Ok(mut slots) = shared.slots.lock() {
+                slots.remove(tag);
+            }
+        }
+    }
+}
+
+/// Text encodings for digests; matches `ct_digest_encoding` in the C header.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum DigestEncoding {
+    /// Lowercase hex, 64 chars.
+    Hex = 0,
+    /// RFC 4648 base32 in lowercase, unpadded, 52 chars.
+    Base32 = 1,
+    /// RFC 4648 base64url, unpadded, 43 chars.
+    Base64Url = 2,
+}
+
+pub const CT_DIGEST_SHORT64_LEN: usize = 8;
+pub const CT_DIGEST_SHORT128_LEN: usize = 16;
+
+extern "C" {
+    fn ct_digest_encoded_len(encoding: DigestEncoding) -> usize;
+    fn ct_digest_encode(
+        encoding: DigestEncoding,
+        digests: *const c_uchar,
+        n: usize,
+        out: *mut c_uchar,
+    ) -> c_int;
+    fn ct_digest_decode(
+        encoding: DigestEncoding,
+        input: *const c_uchar,
+        n: usize,
+        digests: *mut c_uchar,
+    ) -> c_int;
+    fn ct_digest_equal(a: *const c_uchar, b: *const c_uchar) -> c_int;
+    fn ct_digest_equal_batch(
+        needle: *const c_uchar,
+        haystack: *const c_uchar,
+        n: usize,
+        out_eq: *mut c_uchar,
+    );
+    fn ct_digest_find(needle: *const c_uchar, haystack: *const c_uchar, n: usize) -> usize;
+    fn ct_digest_short64(digest: *const c_uchar) -> u64;
+}
+
+type Digest = [u8; CT_RESUME_HASH_LEN];
+
+impl DigestEncoding {
+    /// Encoded length of one digest.
+    pub fn encoded_len(self) -> usize {
+        unsafe { ct_digest_encoded_len(self) }
+    }
+}
+
+/// Encode each digest in one C call; the output is ASCII by construction.
+pub fn encode_digests(digests: &[Digest], encoding: DigestEncoding) -> Vec<String> {
+    let width = encoding.encoded_len();
+    let mut text = vec![0u8; digests.len() * width];
+    unsafe {
+        ct_digest_encode(
+            encoding,
+            digests.as_ptr() as *const c_uchar,
+            digests.len(),
+            text.as_mut_ptr(),
+        );
+    }
+    text.chunks(width)
+        .map(|c| String::from_utf8(c.to_vec()).expect("ascii"))
+        .collect()
+}
+
+pub fn encode_digest(digest: &Digest, encoding: DigestEncoding) -> String {
+    encode_digests(std::slice::from_ref(digest), encoding)
+        .pop()
+        .expect("one digest")
+}
+
+/// Decode digests; fails on a wrong length, invalid characters or
+/// non-canonical trailing bits.
+pub fn decode_digests<S: AsRef<str>>(
+    texts: &[S],
+    encoding: DigestEncoding,
+) -> Result<Vec<Digest>, &'static str> {
+    let width = encoding.encoded_len();
+    let mut joined = Vec::with_capacity(texts.len() * width);
+    for t in texts {
+        if t.as_ref().len() != width {
+            return Err("encoded digest has the wrong length");
+        }
+        joined.extend_from_slice(t.as_ref().as_bytes());
+    }
+    let mut out = vec![[0u8; CT_RESUME_HASH_LEN]; texts.len()];
+    let rc = unsafe {
+        ct_digest_decode(
+            encoding,
+            joined.as_ptr(),
+            texts.len(),
+            out.as_mut_ptr() as *mut c_uchar,
+        )
+    };
+    if rc == 0 {
+        Ok(out)
+    } else {
+        Err("invalid encoded digest")
+    }
+}
+
+pub fn decode_digest(text: &str, encoding: DigestEncoding) -> Result<Digest, &'static str> {
+    decode_digests(&[text], encoding).map(|mut v| v.pop().expect("one digest"))
+}
+
+/// Constant-time equality.
+pub fn digest_eq(a: &Digest, b: &Digest) -> bool {
+    unsafe { ct_digest_equal(a.as_ptr(), b.as_ptr()) == 1 }
+}
+
+/// Per-entry equality against `needle`, without early exit.
+pub fn match_digests(needle: &Digest, haystack: &[Digest]) -> Vec<bool> {
+    let mut eq = vec![0u8; haystack.len()];
+    unsafe {
+        ct_digest_equal_batch(
+            needle.as_ptr(),
+            haystack.as_ptr() as *const c_uchar,
+            haystack.len(),
+            eq.as_mut_ptr(),
+        );
+    }
+    eq.into_iter().map(|e| e == 1).collect()
+}
+
+/// Index of the first entry equal to `needle`; always scans the whole slice.
+pub fn find_digest(needle: &Digest, haystack: &[Digest]) -> Option<usize> {
+    let idx = unsafe {
+        ct_digest_find(needle.as_ptr(), haystack.as_ptr() as *const c_uchar, haystack.len())
+    };
+    if idx < haystack.len() {
+        Some(idx)
+    } else {
+        None
+    }
+}
+
+/// Leading 8 bytes as a big-endian integer, for in-memory index keys.
+/// See the collision budget in `ct_resume_hash.h`; treat a match as a hint
+/// and confirm with the full digest.
+pub fn short64(digest: &Digest) -> u64 {
+    unsafe { ct_digest_short64(digest.as_ptr()) }
+}
+
+/// Leading 16 bytes; collision-safe as an index key at any realistic volume.
+pub fn short128(digest: &Digest) -> [u8; CT_DIGEST_SHORT128_LEN] {
+    let mut out = [0u8; CT_DIGEST_SHORT128_LEN];
+    out.copy_from_slice(&digest[..CT_DIGEST_SHORT128_LEN]);
+    out
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::task::Wake;
+    use std::thread::{self, Thread};
+
+    struct ThreadWaker(Thread);
+
+    impl Wake for ThreadWaker {
+        fn wake(self: Arc<Self>) {
+            self.0.unpark();
+        }
+    }
+
+    // Minimal executor: poll, park until woken, repeat.
+    fn block_on<F: Future>(fut: F) -> F::Output {
+        let mut fut = std::pin::pin!(fut);
+        let waker = Waker::from(Arc::new(ThreadWaker(thread::current())));
+        let mut cx = Context::from_waker(&waker);
+        loop {
+            if let Poll::Ready(out) = fut.as_mut().poll(&mut cx) {
+                return out;
+            }
+            thread::park();
+        }
+    }
+
+    fn large_input(seed: usize) -> String {
+        format!("resume {seed}\n") + &"Lorem ipsum dolor sit amet\n".repeat(16 * 1024)
+    }
+
+    // hash("Hello\nWorld"); encodings cross-checked with Python's base64.
+    const HELLO_WORLD: Digest = [
+        0xb9, 0x4d, 0x27, 0xb9, 0x93, 0x4d, 0x3e, 0x08, 0xa5, 0x2e, 0x52, 0xd7, 0xda, 0x7d, 0xab,
+        0xfa, 0xc4, 0x84, 0xef, 0xe3, 0x7a, 0x53, 0x80, 0xee, 0x90, 0x88, 0xf7, 0xac, 0xe2, 0xef,
+        0xcd, 0xe9,
+    ];
+
+    fn pending_slots(pool: &Pool) -> usize {
+        pool.shared.slots.lock().unwrap().len()
+    }
+
+    #[test]
+    fn hash_async_large_matches_hash_once() {
+        let pool = Pool::new(2, 1024).unwrap();
+        let inputs: Vec<String> = (0..8).map(large_input).collect();
+        let futures: Vec<HashFuture> = inputs.iter().map(|s| pool.hash_async(s)).collect();
+        for (input, fut) in inputs.iter().zip(futures) {
+            assert_eq!(block_on(fut), hash_once(input));
+        }
+        assert_eq!(pending_slots(&pool), 0);
+    }
+
+    #[test]
+    fn hash_async_inline_path() {
+        let pool = Pool::new(1, 64).unwrap();
+        let fut = pool.hash_async("Hello\nWorld");
+        assert!(matches!(fut.state, FutureState::Ready(Some(Ok(_)))));
+        assert_eq!(pending_slots(&pool), 0);
+        assert_eq!(block_on(fut), hash_once("Hello\nWorld"));
+    }
+
+    #[test]
+    fn dropped_futures_release_their_slots() {
+        let pool = Pool::new(2, 0).unwrap();
+        let input = large_input(0);
+        for _ in 0..32 {
+            drop(pool.hash_async(&input));
+        }
+        assert_eq!(pending_slots(&pool), 0);
+
+        // Completions for dropped futures are discarded; new work still runs.
+        assert_eq!(block_on(pool.hash_async(&input)), hash_once(&input));
+        drop(pool);
+    }
+
+    #[test]
+    fn idle_pool_drops_promptly() {
+        // The reactor blocks without a timeout; Drop must wake it.
+        let pool = Pool::new(1, 0).unwrap();
+        thread::sleep(std::time::Duration::from_millis(20));
+        drop(pool);
+    }
+
+    #[test]
+    fn drop_wakes_future_awaited_elsewhere() {
+        let pool = Pool::new(1, 0).unwrap();
+        let input = large_input(3);
+        let expected = hash_once(&input);
+        let fut = pool.hash_async(&input);
+        let waiter = thread::spawn(move || block_on(fut));
+        drop(pool);
+        assert_eq!(waiter.join().unwrap(), expected);
+    }
+
+    #[test]
+    fn future_outlives_pool() {
+        let pool = Pool::new(1, 0).unwrap();
+        let first = large_input(1);
+        let second = large_input(2);
+        let unpolled = pool.hash_async(&first);
+        let mut polled = Box::pin(pool.hash_async(&second));
+
+        let waker = Waker::from(Arc::new(ThreadWaker(thread::current())));
+        let _ = polled.as_mut().poll(&mut Context::from_waker(&waker));
+
+        // Dropping the pool waits for outstanding jobs, so both resolve.
+        drop(pool);
+        assert_eq!(block_on(unpolled), hash_once(&first));
+        assert_eq!(block_on(polled), hash_once(&second));
+    }
+
+    #[test]
+    fn digest_encoding_matches_c_enum() {
+        assert_eq!(DigestEncoding::Hex as i32, 0);
+        assert_eq!(DigestEncoding::Base32 as i32, 1);
+        assert_eq!(DigestEncoding::Base64Url as i32, 2);
+        assert_eq!(DigestEncoding::Hex.encoded_len(), 64);
+        assert_eq!(DigestEncoding::Base32.encoded_len(), 52);
+        assert_eq!(DigestEncoding::Base64Url.encoded_len(), 43);
+    }
+
+    #[test]
+    fn encode_decode_round_trip() {
+        assert_eq!(hash_once("Hello\nWorld"), Ok(HELLO_WORLD));
+        let known = [
+            (
+                DigestEncoding::Hex,
+                "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9",
+            ),
+            (
+                DigestEncoding::Base32,
+                "xfgspomtju7arjjokll5u7nl7lcij37dpjjyb3uqrd32zyxpzxuq",
+            ),
+            (
+                DigestEncoding::Base64Url,
+                "uU0nuZNNPgilLlLX2n2r-sSE7-N6U4DukIj3rOLvzek",
+            ),
+        ];
+        let digests: Vec<Digest> = (0..4u8)
+            .map(|i| [i.wrapping_mul(67); CT_RESUME_HASH_LEN])
+            .collect();
+        for (encoding, text) in known {
+            assert_eq!(encode_digest(&HELLO_WORLD, encoding), text);
+            assert_eq!(decode_digest(text, encoding), Ok(HELLO_WORLD));
+
+            let texts = encode_digests(&digests, encoding);
+            assert_eq!(texts.len(), digests.len());
+            assert!(texts.iter().all(|t| t.len() == encoding.encoded_len()));
+            assert_eq!(decode_digests(&texts, encoding), Ok(digests.clone()));
+        }
+    }
+
+    #[test]
+    fn decode_rejects_invalid_input() {
+        let hex = encode_digest(&HELLO_WORLD, DigestEncoding::Hex);
+        assert!(decode_digest(&hex[1..], DigestEncoding::Hex).is_err());
+        assert!(decode_digest(&hex.replace('b', "g"), DigestEncoding::Hex).is_err());
+        // Standard base64 '+' is not base64url.
+        let b64 = encode_digest(&HELLO_WORLD, DigestEncoding::Base64Url).replace('-', "+");
+        assert!(decode_digest(&b64, DigestEncoding::Base64Url).is_err());
+        // One bad entry fails the whole batch.
+        assert!(decode_digests(&[hex.clone(), hex.replace('9', "z")], DigestEncoding::Hex).is_err());
+    }
+
+    #[test]
+    fn find_and_match_digests() {
+        let mut other = HELLO_WORLD;
+        other[31] ^= 1;
+        let haystack = [other, HELLO_WORLD, other, HELLO_WORLD];
+
+        assert!(digest_eq(&HELLO_WORLD, &haystack[1]));
+        assert!(!digest_eq(&HELLO_WORLD, &other));
+        assert_eq!(match_digests(&HELLO_WORLD, &haystack), vec![false, true, false, true]);
+        assert_eq!(find_digest(&HELLO_WORLD, &haystack), Some(1));
+        assert_eq!(find_digest(&other, &haystack), Some(0));
+        assert_eq!(find_digest(&HELLO_WORLD, &[other, other]), None);
+        assert_eq!(find_digest(&HELLO_WORLD, &[]), None);
+        assert!(match_digests(&HELLO_WORLD, &[]).is_empty());
+    }
+
+    #[test]
+    fn truncated_digests() {
+        assert_eq!(short64(&HELLO_WORLD), 0xb94d27b9934d3e08);
+        assert_eq!(short128(&HELLO_WORLD)[..], HELLO_WORLD[..CT_DIGEST_SHORT128_LEN]);
+    }
+}
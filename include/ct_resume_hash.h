@@ -40,6 +40,153 @@ int ct_resume_hash_update(ct_resume_hash_ctx *ctx,
 int ct_resume_hash_final(ct_resume_hash_ctx *ctx,
                          uint8_t out[CT_RESUME_HASH_LEN]);
 
+typedef struct {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+    size_t entries;
+    size_t bytes;
+    size_t max_bytes;
+} ct_resume_hash_cache_stats;
+
+/**
+ * Optional in-process memo cache in front of `ct_resume_hash_once`
+ * (and therefore `ct_resume_hash_final`). Disabled by default.
+ *
+ * - Keyed on a fast prehash of the raw input bytes plus length; candidates
+ *   are verified against a stored copy of the input before a digest is reused.
+ * - `max_bytes` caps entry overhead plus retained input bytes; eviction is CLOCK.
+ * - The budget is split evenly across 16 shards, so an input is only cached
+ *   if it fits in `max_bytes / 16` together with its entry overhead.
+ * - A hit skips normalization and SHA-256, so repeated inputs no longer take
+ *   the constant-time path. Raw input is retained in memory until evicted.
+ * - Enabling again resizes the budget; disabling frees all entries and
+ *   resets the counters.
+ * - Returns 0 on success, non-zero if `max_bytes` is below
+ *   `CT_RESUME_HASH_CACHE_MIN_BYTES` (16 shards x 4 KiB).
+ */
+#define CT_RESUME_HASH_CACHE_MIN_BYTES (16u * 4096u)
+
+int ct_resume_hash_cache_enable(size_t max_bytes);
+void ct_resume_hash_cache_disable(void);
+void ct_resume_hash_cache_get_stats(ct_resume_hash_cache_stats *out);
+
+typedef struct ct_resume_hash_pool ct_resume_hash_pool;
+
+typedef struct {
+    uint64_t tag;
+    int rc;
+    uint8_t digest[CT_RESUME_HASH_LEN];
+} ct_resume_hash_completion;
+
+/**
+ * Submission/completion API for event-loop integration.
+ *
+ * - `ct_resume_hash_pool_new` starts `n_workers` threads; inputs of at most
+ *   `inline_max` bytes are hashed on the submitting thread instead.
+ * - `submit` copies the input, so the caller may release it on return.
+ *   Returns 0 when a completion for `tag` will be queued, 1 when the input
+ *   was hashed inline into `inline_out` (only if non-NULL; no completion is
+ *   queued), negative on error.
+ * - `ct_resume_hash_pool_fd` is readable while completions may be pending
+ *   (eventfd on Linux, pipe elsewhere); register it with the event loop and
+ *   call `poll` when it fires. Do not read the fd directly.
+ * - `poll` drains up to `max` completions without blocking; `wait` blocks up
+ *   to `timeout_ms` (-1 = forever) for at least one. Both return the count;
+ *   `wait` returns 0 only once the timeout has expired.
+ * - `free` waits for queued jobs to finish and drops undelivered completions.
+ */
+ct_resume_hash_pool *ct_resume_hash_pool_new(size_t n_workers, size_t inline_max);
+void ct_resume_hash_pool_free(ct_resume_hash_pool *pool);
+int ct_resume_hash_pool_submit(ct_resume_hash_pool *pool,
+                               const uint8_t *input,
+                               size_t input_len,
+                               uint64_t tag,
+                               uint8_t inline_out[CT_RESUME_HASH_LEN]);
+int ct_resume_hash_pool_fd(const ct_resume_hash_pool *pool);
+size_t ct_resume_hash_pool_poll(ct_resume_hash_pool *pool,
+                                ct_resume_hash_completion *out,
+                                size_t max);
+size_t ct_resume_hash_pool_wait(ct_resume_hash_pool *pool,
+                                ct_resume_hash_completion *out,
+                                size_t max,
+                                int timeout_ms);
+
+/**
+ * Digest encodings for `CT_RESUME_HASH_LEN`-byte outputs, over arrays of `n`
+ * contiguous digests. Output is not NUL-terminated.
+ *
+ * - Hex: lowercase, 64 chars; decoding accepts either case.
+ * - Base32: RFC 4648 alphabet in lowercase, unpadded, 52 chars; decoding
+ *   accepts either case.
+ * - Base64url: RFC 4648 section 5 alphabet, unpadded, 43 chars.
+ * - Mapping is table-free and branch-free on digest contents. Decoding
+ *   rejects invalid characters and non-zero trailing bits; it returns 0 on
+ *   success and -1 on invalid input (output contents are then unspecified).
+ */
+#define CT_DIGEST_HEX_LEN 64u
+#define CT_DIGEST_BASE32_LEN 52u
+#define CT_DIGEST_BASE64URL_LEN 43u
+
+typedef enum {
+    CT_DIGEST_HEX = 0,
+    CT_DIGEST_BASE32 = 1,
+    CT_DIGEST_BASE64URL = 2
+} ct_digest_encoding;
+
+size_t ct_digest_encoded_len(ct_digest_encoding encoding);
+int ct_digest_encode(ct_digest_encoding encoding,
+                     const uint8_t *digests,
+                     size_t n,
+                     char *out);
+int ct_digest_decode(ct_digest_encoding encoding,
+                     const char *in,
+                     size_t n,
+                     uint8_t *digests);
+
+/**
+ * Constant-time digest comparisons.
+ *
+ * - `ct_digest_equal` returns 1 if equal, else 0.
+ * - `ct_digest_equal_batch` writes `out_eq[i]` = 1 if `haystack[i]` equals
+ *   `needle`, else 0.
+ * - `ct_digest_find` returns the index of the first match in `haystack`, or
+ *   `n` if none. It always scans all `n` entries.
+ */
+int ct_digest_equal(const uint8_t a[CT_RESUME_HASH_LEN],
+                    const uint8_t b[CT_RESUME_HASH_LEN]);
+void ct_digest_equal_batch(const uint8_t needle[CT_RESUME_HASH_LEN],
+                           const uint8_t *haystack,
+                           size_t n,
+                           uint8_t *out_eq);
+size_t ct_digest_find(const uint8_t needle[CT_RESUME_HASH_LEN],
+                      const uint8_t *haystack,
+                      size_t n);
+
+/**
+ * Truncated digests for in-memory indexes: the leading 8 or 16 bytes.
+ *
+ * Collision budget for n distinct resumes (birthday bound n^2 / 2^(bits+1)):
+ * - 64-bit: ~2.7e-8 at 1e6 entries, ~1e-4 at 6e7, ~0.5 near 5e9.
+ *   Treat as a hint and confirm matches against the full digest.
+ * - 128-bit: ~1.8e-15 at 2^40 (1.1e12) entries; safe as a unique key at any
+ *   realistic volume.
+ * Never use truncated forms as the stored identity.
+ *
+ * - `ct_digest_truncate` copies `short_len` (8 or 16) bytes of each of `n`
+ *   digests into `out`; returns 0, or -1 for another length.
+ * - `ct_digest_short64` returns the leading 8 bytes as a big-endian integer.
+ */
+#define CT_DIGEST_SHORT64_LEN 8u
+#define CT_DIGEST_SHORT128_LEN 16u
+
+int ct_digest_truncate(const uint8_t *digests,
+                       size_t n,
+                       size_t short_len,
+                       uint8_t *out);
+uint64_t ct_digest_short64(const uint8_t digest[CT_RESUME_HASH_LEN]);
+
 #ifdef __cplusplus
 }
 #endif
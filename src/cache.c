@@ -0,0 +1,437 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "cache.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Opt-in memo cache: raw input bytes -> final digest.
+//
+// Keyed on a 64-bit non-cryptographic prehash of the raw bytes (seeded with
+// the length). Every candidate is verified against a stored copy of the raw
+// input before its digest is returned, so prehash collisions only cost time.
+// The table is split into lock-striped shards; each shard holds a slice of
+// the memory budget and evicts with CLOCK (second-chance) when full.
+
+#define CT_CACHE_SHARDS 16u
+#define CT_CACHE_SHARD_BITS 4u
+#define CT_CACHE_BUCKETS 1024u
+#define CT_CACHE_NIL UINT32_MAX
+
+typedef struct {
+    uint64_t prehash;
+    uint8_t *raw;
+    size_t len;
+    uint8_t digest[CT_RESUME_HASH_LEN];
+    uint32_t next; // bucket chain while live, free list while dead
+    uint8_t live;
+    uint8_t referenced;
+} cache_entry;
+
+typedef struct {
+    pthread_mutex_t lock;
+    cache_entry *entries;
+    uint32_t n_entries;
+    uint32_t cap_entries;
+    uint32_t free_head;
+    uint32_t hand;
+    uint32_t live_entries;
+    uint32_t buckets[CT_CACHE_BUCKETS];
+    size_t bytes;
+    size_t budget;
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t insertions;
+    uint64_t evictions;
+} cache_shard;
+
+static cache_shard g_shards[CT_CACHE_SHARDS];
+static pthread_once_t g_once = PTHREAD_ONCE_INIT;
+static atomic_int g_enabled;
+
+static void cache_init_once(void) {
+    for (size_t s = 0; s < CT_CACHE_SHARDS; s++) {
+        cache_shard *shard = &g_shards[s];
+        pthread_mutex_init(&shard->lock, NULL);
+        shard->free_head = CT_CACHE_NIL;
+        for (size_t b = 0; b < CT_CACHE_BUCKETS; b++) {
+            shard->buckets[b] = CT_CACHE_NIL;
+        }
+    }
+}
+
+// ---- prehash (xxHash64-style, scalar 4-lane) ----
+
+#define PH_P1 0x9E3779B185EBCA87ull
+#define PH_P2 0xC2B2AE3D27D4EB4Full
+#define PH_P3 0x165667B19E3779F9ull
+#define PH_P4 0x85EBCA77C2B2AE63ull
+#define PH_P5 0x27D4EB2F165667C5ull
+
+static inline uint64_t rotl64(uint64_t x, unsigned r) {
+    return (x << r) | (x >> (64u - r));
+}
+
+static inline uint64_t load64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t load32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t ph_round(uint64_t acc, uint64_t lane) {
+    acc += lane * PH_P2;
+    acc = rotl64(acc, 31);
+    return acc * PH_P1;
+}
+
+static inline uint64_t ph_merge(uint64_t acc, uint64_t v) {
+    acc ^= ph_round(0, v);
+    return acc * PH_P1 + PH_P4;
+}
+
+static uint64_t prehash64(const uint8_t *p, size_t len) {
+    const uint8_t *end = p + len;
+    uint64_t seed = (uint64_t)len;
+    uint64_t h;
+
+    if (len >= 32) {
+        uint64_t v1 = seed + PH_P1 + PH_P2;
+        uint64_t v2 = seed + PH_P2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PH_P1;
+        const uint8_t *limit = end - 32;
+        do {
+            v1 = ph_round(v1, load64(p));
+            v2 = ph_round(v2, load64(p + 8));
+            v3 = ph_round(v3, load64(p + 16));
+            v4 = ph_round(v4, load64(p + 24));
+            p += 32;
+        } while (p <= limit);
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = ph_merge(h, v1);
+        h = ph_merge(h, v2);
+        h = ph_merge(h, v3);
+        h = ph_merge(h, v4);
+    } else {
+        h = seed + PH_P5;
+    }
+
+    h += (uint64_t)len;
+    while (p + 8 <= end) {
+        h ^= ph_round(0, load64(p));
+        h = rotl64(h, 27) * PH_P1 + PH_P4;
+        p += 8;
+    }
+    if (p + 4 <= end) {
+        h ^= (uint64_t)load32(p) * PH_P1;
+        h = rotl64(h, 23) * PH_P2 + PH_P3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (uint64_t)(*p) * PH_P5;
+        h = rotl64(h, 11) * PH_P1;
+        p++;
+    }
+
+    h ^= h >> 33;
+    h *= PH_P2;
+    h ^= h >> 29;
+    h *= PH_P3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Verification compares the whole buffer without early exit.
+static int bytes_equal(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint64_t diff = 0;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        diff |= load64(a + i) ^ load64(b + i);
+    }
+    for (; i < len; i++) {
+        diff |= (uint64_t)(a[i] ^ b[i]);
+    }
+    return diff == 0;
+}
+
+static inline cache_shard *shard_for(uint64_t prehash) {
+    return &g_shards[prehash >> (64u - CT_CACHE_SHARD_BITS)];
+}
+
+static inline uint32_t bucket_for(uint64_t prehash) {
+    return (uint32_t)(prehash & (CT_CACHE_BUCKETS - 1u));
+}
+
+static inline size_t entry_cost(size_t len) {
+    return sizeof(cache_entry) + len;
+}
+
+static void entry_release(cache_entry *e) {
+    if (e->raw) {
+        memset(e->raw, 0, e->len);
+        free(e->raw);
+    }
+    memset(e->digest, 0, sizeof(e->digest));
+    e->raw = NULL;
+    e->live = 0;
+    e->referenced = 0;
+}
+
+static void shard_unlink(cache_shard *shard, uint32_t idx) {
+    uint32_t *link = &shard->buckets[bucket_for(shard->entries[idx].prehash)];
+    while (*link != CT_CACHE_NIL) {
+        if (*link == idx) {
+            *link = shard->entries[idx].next;
+            return;
+        }
+        link = &shard->entries[*link].next;
+    }
+}
+
+// CLOCK sweep: referenced entries get a second chance, the first
+// unreferenced live entry under the hand is evicted.
+static void shard_evict_one(cache_shard *shard) {
+    while (shard->live_entries > 0) {
+        uint32_t idx = shard->hand;
+        shard->hand = (shard->hand + 1u) % shard->n_entries;
+
+        cache_entry *e = &shard->entries[idx];
+        if (!e->live) {
+            continue;
+        }
+        if (e->referenced) {
+            e->referenced = 0;
+            continue;
+        }
+
+        shard_unlink(shard, idx);
+        shard->bytes -= entry_cost(e->len);
+        entry_release(e);
+        e->next = shard->free_head;
+        shard->free_head = idx;
+        shard->live_entries--;
+        shard->evictions++;
+        return;
+    }
+}
+
+static void shard_clear(cache_shard *shard) {
+    for (uint32_t i = 0; i < shard->n_entries; i++) {
+        if (shard->entries[i].live) {
+            entry_release(&shard->entries[i]);
+        }
+    }
+    free(shard->entries);
+    shard->entries = NULL;
+    shard->n_entries = 0;
+    shard->cap_entries = 0;
+    shard->free_head = CT_CACHE_NIL;
+    shard->hand = 0;
+    shard->live_entries = 0;
+    for (size_t b = 0; b < CT_CACHE_BUCKETS; b++) {
+        shard->buckets[b] = CT_CACHE_NIL;
+    }
+    shard->bytes = 0;
+}
+
+static int shard_alloc_slot(cache_shard *shard, uint32_t *idx) {
+    if (shard->free_head != CT_CACHE_NIL) {
+        *idx = shard->free_head;
+        shard->free_head = shard->entries[*idx].next;
+        return 0;
+    }
+    if (shard->n_entries == shard->cap_entries) {
+        uint32_t new_cap = shard->cap_entries ? shard->cap_entries * 2u : 64u;
+        cache_entry *grown = (cache_entry *)realloc(shard->entries,
+                                                    (size_t)new_cap * sizeof(cache_entry));
+        if (!grown) {
+            return -1;
+        }
+        shard->entries = grown;
+        shard->cap_entries = new_cap;
+    }
+    *idx = shard->n_entries++;
+    return 0;
+}
+
+int ct_cache_lookup(const uint8_t *input, size_t input_len,
+                    uint64_t *prehash,
+                    uint8_t out[CT_RESUME_HASH_LEN]) {
+    if (!atomic_load_explicit(&g_enabled, memory_order_acquire)) {
+        return -1;
+    }
+
+    uint64_t h = prehash64(input, input_len);
+    *prehash = h;
+
+    cache_shard *shard = shard_for(h);
+    int hit = 0;
+
+    pthread_mutex_lock(&shard->lock);
+    uint32_t idx = shard->buckets[bucket_for(h)];
+    while (idx != CT_CACHE_NIL) {
+        cache_entry *e = &shard->entries[idx];
+        if (e->prehash == h && e->len == input_len &&
+            bytes_equal(e->raw, input, input_len)) {
+            memcpy(out, e->digest, CT_RESUME_HASH_LEN);
+            e->referenced = 1;
+            hit = 1;
+            break;
+        }
+        idx = e->next;
+    }
+    if (hit) {
+        shard->hits++;
+    } else {
+        shard->misses++;
+    }
+    pthread_mutex_unlock(&shard->lock);
+
+    return hit;
+}
+
+void ct_cache_insert(const uint8_t *input, size_t input_len,
+                     uint64_t prehash,
+                     const uint8_t digest[CT_RESUME_HASH_LEN]) {
+    if (!atomic_load_explicit(&g_enabled, memory_order_acquire)) {
+        return;
+    }
+
+    cache_shard *shard = shard_for(prehash);
+    size_t cost = entry_cost(input_len);
+
+    // Skip the copy for inputs that can never fit this shard's slice; the
+    // budget is re-checked below in case it shrinks before we relock.
+    pthread_mutex_lock(&shard->lock);
+    int fits = cost <= shard->budget;
+    pthread_mutex_unlock(&shard->lock);
+    if (!fits) {
+        return;
+    }
+
+    // Copy outside the lock; malloc(0) may return NULL, so always reserve a byte.
+    uint8_t *raw = (uint8_t *)malloc(input_len ? input_len : 1u);
+    if (!raw) {
+        return;
+    }
+    if (input_len > 0) {
+        memcpy(raw, input, input_len);
+    }
+
+    pthread_mutex_lock(&shard->lock);
+
+    if (cost > shard->budget) {
+        goto drop;
+    }
+
+    // Another thread may have inserted the same input since our lookup.
+    for (uint32_t idx = shard->buckets[bucket_for(prehash)]; idx != CT_CACHE_NIL;
+         idx = shard->entries[idx].next) {
+        cache_entry *e = &shard->entries[idx];
+        if (e->prehash == prehash && e->len == input_len &&
+            bytes_equal(e->raw, raw, input_len)) {
+            goto drop;
+        }
+    }
+
+    while (shard->bytes + cost > shard->budget && shard->live_entries > 0) {
+        shard_evict_one(shard);
+    }
+
+    uint32_t slot;
+    if (shard_alloc_slot(shard, &slot) != 0) {
+        goto drop;
+    }
+
+    cache_entry *e = &shard->entries[slot];
+    e->prehash = prehash;
+    e->raw = raw;
+    e->len = input_len;
+    memcpy(e->digest, digest, CT_RESUME_HASH_LEN);
+    e->live = 1;
+    e->referenced = 0;
+    e->next = shard->buckets[bucket_for(prehash)];
+    shard->buckets[bucket_for(prehash)] = slot;
+    shard->live_entries++;
+    shard->bytes += cost;
+    shard->insertions++;
+
+    pthread_mutex_unlock(&shard->lock);
+    return;
+
+drop:
+    pthread_mutex_unlock(&shard->lock);
+    if (input_len > 0) {
+        memset(raw, 0, input_len);
+    }
+    free(raw);
+}
+
+int ct_resume_hash_cache_enable(size_t max_bytes) {
+    // Each shard gets an equal slice; below the minimum a slice cannot hold
+    // a useful number of entries (or any at all for budgets under 16 bytes).
+    if (max_bytes < CT_RESUME_HASH_CACHE_MIN_BYTES) {
+        return -1;
+    }
+    pthread_once(&g_once, cache_init_once);
+
+    size_t per_shard = max_bytes / CT_CACHE_SHARDS;
+    for (size_t s = 0; s < CT_CACHE_SHARDS; s++) {
+        cache_shard *shard = &g_shards[s];
+        pthread_mutex_lock(&shard->lock);
+        shard->budget = per_shard;
+        while (shard->bytes > shard->budget && shard->live_entries > 0) {
+            shard_evict_one(shard);
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    atomic_store_explicit(&g_enabled, 1, memory_order_release);
+    return 0;
+}
+
+void ct_resume_hash_cache_disable(void) {
+    pthread_once(&g_once, cache_init_once);
+    atomic_store_explicit(&g_enabled, 0, memory_order_release);
+
+    for (size_t s = 0; s < CT_CACHE_SHARDS; s++) {
+        cache_shard *shard = &g_shards[s];
+        pthread_mutex_lock(&shard->lock);
+        shard_clear(shard);
+        shard->budget = 0;
+        shard->hits = 0;
+        shard->misses = 0;
+        shard->insertions = 0;
+        shard->evictions = 0;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+void ct_resume_hash_cache_get_stats(ct_resume_hash_cache_stats *out) {
+    if (!out) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    pthread_once(&g_once, cache_init_once);
+
+    for (size_t s = 0; s < CT_CACHE_SHARDS; s++) {
+        cache_shard *shard = &g_shards[s];
+        pthread_mutex_lock(&shard->lock);
+        out->hits += shard->hits;
+        out->misses += shard->misses;
+        out->insertions += shard->insertions;
+        out->evictions += shard->evictions;
+        out->entries += shard->live_entries;
+        out->bytes += shard->bytes;
+        out->max_bytes += shard->budget;
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
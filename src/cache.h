@@ -0,0 +1,19 @@
+#ifndef CT_RESUME_HASH_CACHE_H
+#define CT_RESUME_HASH_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ct_resume_hash.h"
+
+// Returns 1 on a verified hit (digest written to `out`), 0 on a miss
+// (`prehash` filled for the follow-up insert), -1 when the cache is disabled.
+int ct_cache_lookup(const uint8_t *input, size_t input_len,
+                    uint64_t *prehash,
+                    uint8_t out[CT_RESUME_HASH_LEN]);
+
+void ct_cache_insert(const uint8_t *input, size_t input_len,
+                     uint64_t prehash,
+                     const uint8_t digest[CT_RESUME_HASH_LEN]);
+
+#endif // CT_RESUME_HASH_CACHE_H
@@ -0,0 +1,21 @@
+#ifndef CT_RESUME_HASH_CPU_DISPATCH_H
+#define CT_RESUME_HASH_CPU_DISPATCH_H
+
+// Per-ISA clones of the hot kernels, selected once at load time via IFUNC.
+//
+// Enabled with the CMake option CT_RESUME_HASH_MULTIVERSION, which only
+// defines CT_RESUME_HASH_MULTIVERSION after probing that the toolchain and
+// libc support `target_clones`. Clones are compiled from the same source
+// with the same flags (-fwrapv, -fno-builtin-memcmp), so the mask-based
+// normalization stays branch-free; only instruction selection changes.
+
+#if defined(CT_RESUME_HASH_MULTIVERSION) && defined(__x86_64__)
+#define CT_HOT_KERNEL \
+    __attribute__((target_clones("default", "arch=x86-64-v2", "arch=x86-64-v3", "arch=x86-64-v4")))
+#elif defined(CT_RESUME_HASH_MULTIVERSION) && defined(__aarch64__)
+#define CT_HOT_KERNEL __attribute__((target_clones("default", "sve", "sve2")))
+#else
+#define CT_HOT_KERNEL
+#endif
+
+#endif // CT_RESUME_HASH_CPU_DISPATCH_H
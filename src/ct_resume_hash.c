@@ -1,4 +1,5 @@
 #include "ct_resume_hash.h"
+#include "cache.h"
 #include "hash_core.h"
 #include "normalize.h"
 
@@ -24,6 +25,12 @@ int ct_resume_hash_once(const uint8_t *input,
         return -1;
     }
 
+    uint64_t prehash = 0;
+    int cached = ct_cache_lookup(input, input_len, &prehash, out);
+    if (cached == 1) {
+        return 0;
+    }
+
     // worst-case output length: input_len + 2 for trimming
     uint8_t *buf = (uint8_t *)malloc(input_len + 2);
     if (!buf) {
@@ -39,6 +46,10 @@ int ct_resume_hash_once(const uint8_t *input,
     }
     free(buf);
 
+    if (rc == 0 && cached == 0) {
+        ct_cache_insert(input, input_len, prehash, out);
+    }
+
     return rc;
 }
 
@@ -87,6 +98,10 @@ int ct_resume_hash_update(ct_resume_hash_ctx *ctx,
     if (!ctx || !chunk) {
         return -1;
     }
+    // Nothing to append; also avoids memcpy on a still-NULL buffer.
+    if (chunk_len == 0) {
+        return 0;
+    }
     if (ensure_capacity(ctx, chunk_len) != 0) {
         return -2;
     }
@@ -100,8 +115,13 @@ int ct_resume_hash_final(ct_resume_hash_ctx *ctx,
     if (!ctx || !out) {
         return -1;
     }
-    int rc = ct_resume_hash_once(ctx->buffer, ctx->len, out);
-    memset(ctx->buffer, 0, ctx->len);
+    // Nothing appended yet: hash the empty input like ct_resume_hash_once("").
+    static const uint8_t empty[1] = {0};
+    const uint8_t *input = ctx->buffer ? ctx->buffer : empty;
+    int rc = ct_resume_hash_once(input, ctx->len, out);
+    if (ctx->buffer) {
+        memset(ctx->buffer, 0, ctx->len);
+    }
     free(ctx->buffer);
     ctx->buffer = NULL;
     ctx->len = 0;
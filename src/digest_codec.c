@@ -0,0 +1,463 @@
+#include "ct_resume_hash.h"
+#include "digest_simd.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Digest encodings and comparisons.
+//
+// Character mapping is done with arithmetic and masks rather than lookup
+// tables, so neither encoding nor decoding makes digest-dependent memory
+// accesses or branches. The scalar code below is the reference; the vector
+// kernels in digest_simd_*.c follow the same rules and are picked per call
+// from the CPU's features, never from the data.
+
+// ---- kernel selection ----
+
+static atomic_int g_isa = -1; // -1 until first use
+
+static int detect_isa(void) {
+#if defined(CT_DIGEST_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return CT_DIGEST_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        return CT_DIGEST_ISA_SSSE3;
+    }
+    return CT_DIGEST_ISA_SSE2;
+#elif defined(CT_DIGEST_SIMD_NEON)
+    return CT_DIGEST_ISA_NEON;
+#else
+    return CT_DIGEST_ISA_SCALAR;
+#endif
+}
+
+int ct_digest_simd_isa(void) {
+    int isa = atomic_load_explicit(&g_isa, memory_order_relaxed);
+    if (isa < 0) {
+        isa = detect_isa();
+        atomic_store_explicit(&g_isa, isa, memory_order_relaxed);
+    }
+    return isa;
+}
+
+int ct_digest_simd_set_isa(int isa) {
+    int best = detect_isa();
+    if (isa < 0 || isa > best) {
+        isa = best;
+    }
+#if !defined(CT_DIGEST_SIMD_X86)
+    // Only the x86 levels nest; elsewhere it is the best level or scalar.
+    if (isa != best) {
+        isa = CT_DIGEST_ISA_SCALAR;
+    }
+#endif
+    atomic_store_explicit(&g_isa, isa, memory_order_relaxed);
+    return isa;
+}
+
+// All-ones if lo <= c <= hi, else zero.
+static inline uint32_t mask_range(int c, int lo, int hi) {
+    return (uint32_t)-(int32_t)((c >= lo) & (c <= hi));
+}
+
+// ---- hex: 0-9a-f, decode accepts either case ----
+
+static inline char hex_char(uint32_t v) {
+    int x = (int)v;
+    return (char)(x + '0' + (((9 - x) >> 31) & ('a' - '0' - 10)));
+}
+
+static inline uint32_t hex_val(uint8_t ch, uint32_t *bad) {
+    int c = ch;
+    int lower = c | 0x20;
+    uint32_t is_digit = mask_range(c, '0', '9');
+    uint32_t is_alpha = mask_range(lower, 'a', 'f');
+    *bad |= ~(is_digit | is_alpha);
+    return ((uint32_t)(c - '0') & is_digit) | ((uint32_t)(lower - 'a' + 10) & is_alpha);
+}
+
+static void hex_encode_scalar(const uint8_t *d, size_t n, char *out) {
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i++) {
+        out[2 * i] = hex_char(d[i] >> 4);
+        out[2 * i + 1] = hex_char(d[i] & 0x0f);
+    }
+}
+
+static uint32_t hex_decode_scalar(const char *in, size_t n, uint8_t *d) {
+    uint32_t bad = 0;
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i++) {
+        uint32_t hi = hex_val((uint8_t)in[2 * i], &bad);
+        uint32_t lo = hex_val((uint8_t)in[2 * i + 1], &bad);
+        d[i] = (uint8_t)((hi << 4) | lo);
+    }
+    return bad;
+}
+
+static void hex_encode(const uint8_t *d, size_t n, char *out) {
+    int isa = ct_digest_simd_isa();
+#if defined(CT_DIGEST_SIMD_X86)
+    if (isa >= CT_DIGEST_ISA_AVX2) {
+        ct_hex_encode_avx2(d, n, out);
+        return;
+    }
+    if (isa >= CT_DIGEST_ISA_SSE2) {
+        ct_hex_encode_sse2(d, n, out);
+        return;
+    }
+#elif defined(CT_DIGEST_SIMD_NEON)
+    if (isa == CT_DIGEST_ISA_NEON) {
+        ct_hex_encode_neon(d, n, out);
+        return;
+    }
+#endif
+    (void)isa;
+    hex_encode_scalar(d, n, out);
+}
+
+static uint32_t hex_decode(const char *in, size_t n, uint8_t *d) {
+    int isa = ct_digest_simd_isa();
+#if defined(CT_DIGEST_SIMD_X86)
+    if (isa >= CT_DIGEST_ISA_AVX2) {
+        return ct_hex_decode_avx2(in, n, d);
+    }
+    if (isa >= CT_DIGEST_ISA_SSE2) {
+        return ct_hex_decode_sse2(in, n, d);
+    }
+#elif defined(CT_DIGEST_SIMD_NEON)
+    if (isa == CT_DIGEST_ISA_NEON) {
+        return ct_hex_decode_neon(in, n, d);
+    }
+#endif
+    (void)isa;
+    return hex_decode_scalar(in, n, d);
+}
+
+// ---- base32: RFC 4648 alphabet, lowercase, unpadded (52 chars) ----
+
+static inline char b32_char(uint32_t v) {
+    int x = (int)v;
+    return (char)(x + 'a' + (((25 - x) >> 31) & ('2' - 'a' - 26)));
+}
+
+static inline uint32_t b32_val(uint8_t ch, uint32_t *bad) {
+    int lower = ch | 0x20;
+    uint32_t is_alpha = mask_range(lower, 'a', 'z');
+    uint32_t is_digit = mask_range(ch, '2', '7');
+    *bad |= ~(is_alpha | is_digit);
+    return ((uint32_t)(lower - 'a') & is_alpha) | ((uint32_t)(ch - '2' + 26) & is_digit);
+}
+
+static void b32_encode_one(const uint8_t *d, char *out) {
+    // 6 full 5-byte groups, then 2 bytes -> 4 chars (last 4 bits zero).
+    for (size_t g = 0; g < 6; g++) {
+        const uint8_t *p = d + 5 * g;
+        uint64_t v = (uint64_t)p[0] << 32 | (uint64_t)p[1] << 24 | (uint64_t)p[2] << 16 |
+                     (uint64_t)p[3] << 8 | (uint64_t)p[4];
+        for (size_t k = 0; k < 8; k++) {
+            out[8 * g + k] = b32_char((uint32_t)(v >> (35 - 5 * k)) & 31u);
+        }
+    }
+    uint32_t v = (uint32_t)d[30] << 12 | (uint32_t)d[31] << 4;
+    for (size_t k = 0; k < 4; k++) {
+        out[48 + k] = b32_char((v >> (15 - 5 * k)) & 31u);
+    }
+}
+
+static uint32_t b32_decode_one(const char *in, uint8_t *d) {
+    uint32_t bad = 0;
+    for (size_t g = 0; g < 6; g++) {
+        uint64_t v = 0;
+        for (size_t k = 0; k < 8; k++) {
+            v = (v << 5) | b32_val((uint8_t)in[8 * g + k], &bad);
+        }
+        for (size_t k = 0; k < 5; k++) {
+            d[5 * g + k] = (uint8_t)(v >> (32 - 8 * k));
+        }
+    }
+    uint32_t v = 0;
+    for (size_t k = 0; k < 4; k++) {
+        v = (v << 5) | b32_val((uint8_t)in[48 + k], &bad);
+    }
+    d[30] = (uint8_t)(v >> 12);
+    d[31] = (uint8_t)(v >> 4);
+    // Non-zero padding bits would give two spellings of one digest.
+    bad |= v & 0x0f;
+    return bad;
+}
+
+static void b32_encode(const uint8_t *d, size_t n, char *out) {
+#if defined(CT_DIGEST_SIMD_X86)
+    if (ct_digest_simd_isa() >= CT_DIGEST_ISA_SSSE3) {
+        ct_b32_encode_ssse3(d, n, out);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++) {
+        b32_encode_one(d + i * CT_RESUME_HASH_LEN, out + i * CT_DIGEST_BASE32_LEN);
+    }
+}
+
+static uint32_t b32_decode(const char *in, size_t n, uint8_t *d) {
+#if defined(CT_DIGEST_SIMD_X86)
+    if (ct_digest_simd_isa() >= CT_DIGEST_ISA_SSSE3) {
+        return ct_b32_decode_ssse3(in, n, d);
+    }
+#endif
+    uint32_t bad = 0;
+    for (size_t i = 0; i < n; i++) {
+        bad |= b32_decode_one(in + i * CT_DIGEST_BASE32_LEN, d + i * CT_RESUME_HASH_LEN);
+    }
+    return bad;
+}
+
+// ---- base64url: RFC 4648 section 5 alphabet, unpadded (43 chars) ----
+
+static inline char b64_char(uint32_t v) {
+    int x = (int)v;
+    // Start from the A-Z offset and add the delta to each later range.
+    int c = x + 'A';
+    c += ((25 - x) >> 31) & (('a' - 26) - 'A');
+    c += ((51 - x) >> 31) & (('0' - 52) - ('a' - 26));
+    c += ((61 - x) >> 31) & (('-' - 62) - ('0' - 52));
+    c += ((62 - x) >> 31) & (('_' - 63) - ('-' - 62));
+    return (char)c;
+}
+
+static inline uint32_t b64_val(uint8_t ch, uint32_t *bad) {
+    int c = ch;
+    uint32_t up = mask_range(c, 'A', 'Z');
+    uint32_t lo = mask_range(c, 'a', 'z');
+    uint32_t dg = mask_range(c, '0', '9');
+    uint32_t dash = mask_range(c, '-', '-');
+    uint32_t under = mask_range(c, '_', '_');
+    *bad |= ~(up | lo | dg | dash | under);
+    return ((uint32_t)(c - 'A') & up) | ((uint32_t)(c - 'a' + 26) & lo) |
+           ((uint32_t)(c - '0' + 52) & dg) | (62u & dash) | (63u & under);
+}
+
+static void b64_encode_one(const uint8_t *d, char *out) {
+    // 10 full 3-byte groups, then 2 bytes -> 3 chars (last 2 bits zero).
+    for (size_t g = 0; g < 10; g++) {
+        const uint8_t *p = d + 3 * g;
+        uint32_t v = (uint32_t)p[0] << 16 | (uint32_t)p[1] << 8 | (uint32_t)p[2];
+        for (size_t k = 0; k < 4; k++) {
+            out[4 * g + k] = b64_char((v >> (18 - 6 * k)) & 63u);
+        }
+    }
+    uint32_t v = (uint32_t)d[30] << 10 | (uint32_t)d[31] << 2;
+    for (size_t k = 0; k < 3; k++) {
+        out[40 + k] = b64_char((v >> (12 - 6 * k)) & 63u);
+    }
+}
+
+static uint32_t b64_decode_one(const char *in, uint8_t *d) {
+    uint32_t bad = 0;
+    for (size_t g = 0; g < 10; g++) {
+        uint32_t v = 0;
+        for (size_t k = 0; k < 4; k++) {
+            v = (v << 6) | b64_val((uint8_t)in[4 * g + k], &bad);
+        }
+        d[3 * g] = (uint8_t)(v >> 16);
+        d[3 * g + 1] = (uint8_t)(v >> 8);
+        d[3 * g + 2] = (uint8_t)v;
+    }
+    uint32_t v = 0;
+    for (size_t k = 0; k < 3; k++) {
+        v = (v << 6) | b64_val((uint8_t)in[40 + k], &bad);
+    }
+    d[30] = (uint8_t)(v >> 10);
+    d[31] = (uint8_t)(v >> 2);
+    bad |= v & 0x03;
+    return bad;
+}
+
+static void b64_encode(const uint8_t *d, size_t n, char *out) {
+#if defined(CT_DIGEST_SIMD_X86)
+    if (ct_digest_simd_isa() >= CT_DIGEST_ISA_SSSE3) {
+        ct_b64_encode_ssse3(d, n, out);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; i++) {
+        b64_encode_one(d + i * CT_RESUME_HASH_LEN, out + i * CT_DIGEST_BASE64URL_LEN);
+    }
+}
+
+static uint32_t b64_decode(const char *in, size_t n, uint8_t *d) {
+#if defined(CT_DIGEST_SIMD_X86)
+    if (ct_digest_simd_isa() >= CT_DIGEST_ISA_SSSE3) {
+        return ct_b64_decode_ssse3(in, n, d);
+    }
+#endif
+    uint32_t bad = 0;
+    for (size_t i = 0; i < n; i++) {
+        bad |= b64_decode_one(in + i * CT_DIGEST_BASE64URL_LEN, d + i * CT_RESUME_HASH_LEN);
+    }
+    return bad;
+}
+
+size_t ct_digest_encoded_len(ct_digest_encoding encoding) {
+    switch (encoding) {
+    case CT_DIGEST_HEX:
+        return CT_DIGEST_HEX_LEN;
+    case CT_DIGEST_BASE32:
+        return CT_DIGEST_BASE32_LEN;
+    case CT_DIGEST_BASE64URL:
+        return CT_DIGEST_BASE64URL_LEN;
+    }
+    return 0;
+}
+
+int ct_digest_encode(ct_digest_encoding encoding,
+                     const uint8_t *digests,
+                     size_t n,
+                     char *out) {
+    if (!digests || !out) {
+        return -1;
+    }
+    switch (encoding) {
+    case CT_DIGEST_HEX:
+        hex_encode(digests, n, out);
+        return 0;
+    case CT_DIGEST_BASE32:
+        b32_encode(digests, n, out);
+        return 0;
+    case CT_DIGEST_BASE64URL:
+        b64_encode(digests, n, out);
+        return 0;
+    }
+    return -1;
+}
+
+int ct_digest_decode(ct_digest_encoding encoding,
+                     const char *in,
+                     size_t n,
+                     uint8_t *digests) {
+    if (!in || !digests) {
+        return -1;
+    }
+    switch (encoding) {
+    case CT_DIGEST_HEX:
+        return hex_decode(in, n, digests) ? -1 : 0;
+    case CT_DIGEST_BASE32:
+        return b32_decode(in, n, digests) ? -1 : 0;
+    case CT_DIGEST_BASE64URL:
+        return b64_decode(in, n, digests) ? -1 : 0;
+    }
+    return -1;
+}
+
+// ---- comparisons: whole-digest XOR/OR over four 64-bit words ----
+
+static inline uint64_t load64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t digest_diff(const uint8_t *a, const uint8_t *b) {
+    return (load64(a) ^ load64(b)) | (load64(a + 8) ^ load64(b + 8)) |
+           (load64(a + 16) ^ load64(b + 16)) | (load64(a + 24) ^ load64(b + 24));
+}
+
+// 1 if diff == 0, else 0, without a data-dependent branch.
+static inline uint64_t is_zero(uint64_t diff) {
+    return 1u ^ ((diff | (0u - diff)) >> 63);
+}
+
+int ct_digest_equal(const uint8_t a[CT_RESUME_HASH_LEN],
+                    const uint8_t b[CT_RESUME_HASH_LEN]) {
+    if (!a || !b) {
+        return 0;
+    }
+    return (int)is_zero(digest_diff(a, b));
+}
+
+void ct_digest_equal_batch(const uint8_t needle[CT_RESUME_HASH_LEN],
+                           const uint8_t *haystack,
+                           size_t n,
+                           uint8_t *out_eq) {
+    if (!needle || !haystack || !out_eq) {
+        return;
+    }
+    int isa = ct_digest_simd_isa();
+#if defined(CT_DIGEST_SIMD_X86)
+    if (isa >= CT_DIGEST_ISA_AVX2) {
+        ct_equal_batch_avx2(needle, haystack, n, out_eq);
+        return;
+    }
+    if (isa >= CT_DIGEST_ISA_SSE2) {
+        ct_equal_batch_sse2(needle, haystack, n, out_eq);
+        return;
+    }
+#elif defined(CT_DIGEST_SIMD_NEON)
+    if (isa == CT_DIGEST_ISA_NEON) {
+        ct_equal_batch_neon(needle, haystack, n, out_eq);
+        return;
+    }
+#endif
+    (void)isa;
+    for (size_t i = 0; i < n; i++) {
+        out_eq[i] = (uint8_t)is_zero(digest_diff(needle, haystack + i * CT_RESUME_HASH_LEN));
+    }
+}
+
+size_t ct_digest_find(const uint8_t needle[CT_RESUME_HASH_LEN],
+                      const uint8_t *haystack,
+                      size_t n) {
+    if (!needle || !haystack) {
+        return n;
+    }
+    int isa = ct_digest_simd_isa();
+#if defined(CT_DIGEST_SIMD_X86)
+    if (isa >= CT_DIGEST_ISA_AVX2) {
+        return ct_find_avx2(needle, haystack, n);
+    }
+    if (isa >= CT_DIGEST_ISA_SSE2) {
+        return ct_find_sse2(needle, haystack, n);
+    }
+#elif defined(CT_DIGEST_SIMD_NEON)
+    if (isa == CT_DIGEST_ISA_NEON) {
+        return ct_find_neon(needle, haystack, n);
+    }
+#endif
+    (void)isa;
+    // Scan everything; remember the first hit with masks instead of breaking.
+    size_t found = n;
+    size_t have = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t hit = (size_t)0 - (size_t)is_zero(digest_diff(needle, haystack + i * CT_RESUME_HASH_LEN));
+        size_t take = hit & ~have;
+        found = (found & ~take) | (i & take);
+        have |= hit;
+    }
+    return found;
+}
+
+// ---- truncated forms ----
+
+int ct_digest_truncate(const uint8_t *digests,
+                       size_t n,
+                       size_t short_len,
+                       uint8_t *out) {
+    if (!digests || !out ||
+        (short_len != CT_DIGEST_SHORT64_LEN && short_len != CT_DIGEST_SHORT128_LEN)) {
+        return -1;
+    }
+    for (size_t i = 0; i < n; i++) {
+        memcpy(out + i * short_len, digests + i * CT_RESUME_HASH_LEN, short_len);
+    }
+    return 0;
+}
+
+uint64_t ct_digest_short64(const uint8_t digest[CT_RESUME_HASH_LEN]) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < CT_DIGEST_SHORT64_LEN; i++) {
+        v = (v << 8) | digest[i];
+    }
+    return v;
+}
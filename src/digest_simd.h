@@ -0,0 +1,62 @@
+#ifndef CT_RESUME_HASH_DIGEST_SIMD_H
+#define CT_RESUME_HASH_DIGEST_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Vector kernels behind ct_digest_encode/decode/equal_batch/find.
+//
+// Each kernel handles `n` whole digests and matches the scalar code in
+// digest_codec.c byte for byte, including which inputs decoding rejects.
+// Character mapping stays table-free: ranges are found with vector compares
+// and masks, and byte shuffles only use constant indices, so nothing indexes
+// memory or branches on digest contents. Decoders return 0 if every character
+// was valid and canonical, non-zero otherwise.
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CT_DIGEST_SIMD_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define CT_DIGEST_SIMD_NEON 1
+#endif
+
+// Kernel levels; on x86-64 each level also enables the ones below it.
+enum {
+    CT_DIGEST_ISA_SCALAR = 0,
+    CT_DIGEST_ISA_SSE2 = 1,  // hex, comparisons
+    CT_DIGEST_ISA_SSSE3 = 2, // + base32, base64url
+    CT_DIGEST_ISA_AVX2 = 3,  // 256-bit hex, comparisons
+    CT_DIGEST_ISA_NEON = 4   // aarch64: hex, comparisons
+};
+
+// Selected level: the best the CPU supports unless a test pinned one.
+int ct_digest_simd_isa(void);
+
+// Test hook: pin the level used by later calls (-1 restores auto-detection).
+// Returns the level now in effect, which differs from `isa` if the CPU lacks it.
+int ct_digest_simd_set_isa(int isa);
+
+#ifdef CT_DIGEST_SIMD_X86
+void ct_hex_encode_sse2(const uint8_t *d, size_t n, char *out);
+uint32_t ct_hex_decode_sse2(const char *in, size_t n, uint8_t *d);
+void ct_hex_encode_avx2(const uint8_t *d, size_t n, char *out);
+uint32_t ct_hex_decode_avx2(const char *in, size_t n, uint8_t *d);
+
+void ct_b32_encode_ssse3(const uint8_t *d, size_t n, char *out);
+uint32_t ct_b32_decode_ssse3(const char *in, size_t n, uint8_t *d);
+void ct_b64_encode_ssse3(const uint8_t *d, size_t n, char *out);
+uint32_t ct_b64_decode_ssse3(const char *in, size_t n, uint8_t *d);
+
+void ct_equal_batch_sse2(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq);
+size_t ct_find_sse2(const uint8_t *needle, const uint8_t *haystack, size_t n);
+void ct_equal_batch_avx2(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq);
+size_t ct_find_avx2(const uint8_t *needle, const uint8_t *haystack, size_t n);
+#endif
+
+#ifdef CT_DIGEST_SIMD_NEON
+void ct_hex_encode_neon(const uint8_t *d, size_t n, char *out);
+uint32_t ct_hex_decode_neon(const char *in, size_t n, uint8_t *d);
+void ct_equal_batch_neon(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq);
+size_t ct_find_neon(const uint8_t *needle, const uint8_t *haystack, size_t n);
+#endif
+
+#endif // CT_RESUME_HASH_DIGEST_SIMD_H
@@ -0,0 +1,84 @@
+#include "ct_resume_hash.h"
+#include "digest_simd.h"
+
+#ifdef CT_DIGEST_SIMD_NEON
+
+#include <arm_neon.h>
+
+// All-ones bytes where lo <= c <= hi (unsigned).
+static inline uint8x16_t range_neon(uint8x16_t c, uint8_t lo, uint8_t hi) {
+    return vandq_u8(vcgeq_u8(c, vdupq_n_u8(lo)), vcleq_u8(c, vdupq_n_u8(hi)));
+}
+
+static inline uint8x16_t hex_chars_neon(uint8x16_t nib) {
+    uint8x16_t alpha = vcgtq_u8(nib, vdupq_n_u8(9));
+    return vaddq_u8(vaddq_u8(nib, vdupq_n_u8('0')),
+                    vandq_u8(alpha, vdupq_n_u8('a' - '0' - 10)));
+}
+
+static inline uint8x16_t hex_vals_neon(uint8x16_t c, uint8x16_t *bad) {
+    uint8x16_t lower = vorrq_u8(c, vdupq_n_u8(0x20));
+    uint8x16_t is_digit = range_neon(c, '0', '9');
+    uint8x16_t is_alpha = range_neon(lower, 'a', 'f');
+    *bad = vorrq_u8(*bad, vmvnq_u8(vorrq_u8(is_digit, is_alpha)));
+    return vorrq_u8(vandq_u8(vsubq_u8(c, vdupq_n_u8('0')), is_digit),
+                    vandq_u8(vsubq_u8(lower, vdupq_n_u8('a' - 10)), is_alpha));
+}
+
+// vst2/vld2 interleave and de-interleave the high and low nibble chars.
+void ct_hex_encode_neon(const uint8_t *d, size_t n, char *out) {
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 16) {
+        uint8x16_t x = vld1q_u8(d + i);
+        uint8x16x2_t chars;
+        chars.val[0] = hex_chars_neon(vshrq_n_u8(x, 4));
+        chars.val[1] = hex_chars_neon(vandq_u8(x, vdupq_n_u8(0x0f)));
+        vst2q_u8((uint8_t *)out + 2 * i, chars);
+    }
+}
+
+uint32_t ct_hex_decode_neon(const char *in, size_t n, uint8_t *d) {
+    uint8x16_t bad = vdupq_n_u8(0);
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 16) {
+        uint8x16x2_t chars = vld2q_u8((const uint8_t *)in + 2 * i);
+        uint8x16_t hi = hex_vals_neon(chars.val[0], &bad);
+        uint8x16_t lo = hex_vals_neon(chars.val[1], &bad);
+        vst1q_u8(d + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+    }
+    return vmaxvq_u8(bad);
+}
+
+// 1 if the 32 bytes at h equal the needle halves, else 0; no branches.
+static inline size_t eq_neon(uint8x16_t n0, uint8x16_t n1, const uint8_t *h) {
+    uint8x16_t x = vorrq_u8(veorq_u8(n0, vld1q_u8(h)), veorq_u8(n1, vld1q_u8(h + 16)));
+    uint32_t m = vmaxvq_u8(x);
+    return (size_t)((m - 1u) >> 31);
+}
+
+void ct_equal_batch_neon(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq) {
+    uint8x16_t n0 = vld1q_u8(needle);
+    uint8x16_t n1 = vld1q_u8(needle + 16);
+    for (size_t i = 0; i < n; i++) {
+        out_eq[i] = (uint8_t)eq_neon(n0, n1, haystack + i * CT_RESUME_HASH_LEN);
+    }
+}
+
+size_t ct_find_neon(const uint8_t *needle, const uint8_t *haystack, size_t n) {
+    uint8x16_t n0 = vld1q_u8(needle);
+    uint8x16_t n1 = vld1q_u8(needle + 16);
+    size_t found = n;
+    size_t have = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t hit = (size_t)0 - eq_neon(n0, n1, haystack + i * CT_RESUME_HASH_LEN);
+        size_t take = hit & ~have;
+        found = (found & ~take) | (i & take);
+        have |= hit;
+    }
+    return found;
+}
+
+#else
+
+// Keep the translation unit non-empty for -pedantic.
+typedef int ct_digest_simd_neon_unused;
+
+#endif // CT_DIGEST_SIMD_NEON
@@ -0,0 +1,407 @@
+#include "ct_resume_hash.h"
+#include "digest_simd.h"
+
+#include <string.h>
+
+#ifdef CT_DIGEST_SIMD_X86
+
+#include <immintrin.h>
+
+// SSE2 is part of the x86-64 baseline; SSSE3 and AVX2 kernels carry a target
+// attribute and are only called after a CPU check in digest_codec.c.
+#define CT_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define CT_TARGET_AVX2 __attribute__((target("avx2")))
+
+// All-ones bytes where lo <= c <= hi. Signed compares: bytes >= 0x80 are
+// negative and fall outside every (ASCII) range.
+static inline __m128i range_sse2(__m128i c, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8((char)(lo - 1))),
+                         _mm_cmplt_epi8(c, _mm_set1_epi8((char)(hi + 1))));
+}
+
+CT_TARGET_AVX2
+static inline __m256i range_avx2(__m256i c, char lo, char hi) {
+    return _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8((char)(lo - 1))),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(hi + 1)), c));
+}
+
+// ---- hex ----
+
+// Nibbles 0..15 -> '0'-'9', 'a'-'f'.
+static inline __m128i hex_chars_sse2(__m128i nib) {
+    __m128i alpha = _mm_cmpgt_epi8(nib, _mm_set1_epi8(9));
+    return _mm_add_epi8(_mm_add_epi8(nib, _mm_set1_epi8('0')),
+                        _mm_and_si128(alpha, _mm_set1_epi8('a' - '0' - 10)));
+}
+
+// Hex characters -> nibbles; invalid bytes set their lane in *bad.
+static inline __m128i hex_vals_sse2(__m128i c, __m128i *bad) {
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i is_digit = range_sse2(c, '0', '9');
+    __m128i is_alpha = range_sse2(lower, 'a', 'f');
+    *bad = _mm_or_si128(*bad, _mm_xor_si128(_mm_or_si128(is_digit, is_alpha), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('0')), is_digit),
+                        _mm_and_si128(_mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)), is_alpha));
+}
+
+// Pairs of nibbles (high first) in 16-bit lanes -> one byte per lane.
+static inline __m128i hex_join_sse2(__m128i v) {
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(v, _mm_set1_epi16(0x00ff)), 4),
+                        _mm_srli_epi16(v, 8));
+}
+
+void ct_hex_encode_sse2(const uint8_t *d, size_t n, char *out) {
+    const __m128i low4 = _mm_set1_epi8(0x0f);
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(d + i));
+        __m128i hi = hex_chars_sse2(_mm_and_si128(_mm_srli_epi16(x, 4), low4));
+        __m128i lo = hex_chars_sse2(_mm_and_si128(x, low4));
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+}
+
+uint32_t ct_hex_decode_sse2(const char *in, size_t n, uint8_t *d) {
+    __m128i bad = _mm_setzero_si128();
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 16) {
+        __m128i c0 = _mm_loadu_si128((const __m128i *)(in + 2 * i));
+        __m128i c1 = _mm_loadu_si128((const __m128i *)(in + 2 * i + 16));
+        __m128i b0 = hex_join_sse2(hex_vals_sse2(c0, &bad));
+        __m128i b1 = hex_join_sse2(hex_vals_sse2(c1, &bad));
+        _mm_storeu_si128((__m128i *)(d + i), _mm_packus_epi16(b0, b1));
+    }
+    return (uint32_t)_mm_movemask_epi8(bad);
+}
+
+CT_TARGET_AVX2
+static inline __m256i hex_chars_avx2(__m256i nib) {
+    __m256i alpha = _mm256_cmpgt_epi8(nib, _mm256_set1_epi8(9));
+    return _mm256_add_epi8(_mm256_add_epi8(nib, _mm256_set1_epi8('0')),
+                           _mm256_and_si256(alpha, _mm256_set1_epi8('a' - '0' - 10)));
+}
+
+CT_TARGET_AVX2
+static inline __m256i hex_vals_avx2(__m256i c, __m256i *bad) {
+    __m256i lower = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+    __m256i is_digit = range_avx2(c, '0', '9');
+    __m256i is_alpha = range_avx2(lower, 'a', 'f');
+    *bad = _mm256_or_si256(*bad, _mm256_xor_si256(_mm256_or_si256(is_digit, is_alpha),
+                                                  _mm256_set1_epi8(-1)));
+    return _mm256_or_si256(
+        _mm256_and_si256(_mm256_sub_epi8(c, _mm256_set1_epi8('0')), is_digit),
+        _mm256_and_si256(_mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)), is_alpha));
+}
+
+CT_TARGET_AVX2
+static inline __m256i hex_join_avx2(__m256i v) {
+    return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(v, _mm256_set1_epi16(0x00ff)), 4),
+                           _mm256_srli_epi16(v, 8));
+}
+
+// One digest (32 bytes, 64 chars) per iteration. Unpack and pack work within
+// 128-bit lanes, so the halves are put back in order with lane permutes.
+CT_TARGET_AVX2
+void ct_hex_encode_avx2(const uint8_t *d, size_t n, char *out) {
+    const __m256i low4 = _mm256_set1_epi8(0x0f);
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(d + i));
+        __m256i hi = hex_chars_avx2(_mm256_and_si256(_mm256_srli_epi16(x, 4), low4));
+        __m256i lo = hex_chars_avx2(_mm256_and_si256(x, low4));
+        __m256i a = _mm256_unpacklo_epi8(hi, lo); // bytes 0-7 | 16-23
+        __m256i b = _mm256_unpackhi_epi8(hi, lo); // bytes 8-15 | 24-31
+        _mm256_storeu_si256((__m256i *)(out + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+}
+
+CT_TARGET_AVX2
+uint32_t ct_hex_decode_avx2(const char *in, size_t n, uint8_t *d) {
+    __m256i bad = _mm256_setzero_si256();
+    for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i += 32) {
+        __m256i c0 = _mm256_loadu_si256((const __m256i *)(in + 2 * i));
+        __m256i c1 = _mm256_loadu_si256((const __m256i *)(in + 2 * i + 32));
+        __m256i b0 = hex_join_avx2(hex_vals_avx2(c0, &bad));
+        __m256i b1 = hex_join_avx2(hex_vals_avx2(c1, &bad));
+        // packus interleaves 64-bit quarters as 0-7, 16-23, 8-15, 24-31.
+        __m256i packed = _mm256_packus_epi16(b0, b1);
+        _mm256_storeu_si256((__m256i *)(d + i), _mm256_permute4x64_epi64(packed, 0xd8));
+    }
+    return (uint32_t)_mm256_movemask_epi8(bad);
+}
+
+// ---- base32: 5-byte groups -> 8 chars ----
+
+// Gathers one 5-byte group starting at `b` in the register into eight
+// big-endian 16-bit words, one per output char; -1 lanes read as zero.
+#define B32_GATHER(b)                                                                  \
+    _mm_setr_epi8((char)((b) + 1), (char)(b), (char)((b) + 1), (char)(b),             \
+                  (char)((b) + 2), (char)((b) + 1), (char)((b) + 2), (char)((b) + 1), \
+                  (char)((b) + 3), (char)((b) + 2), (char)((b) + 4), (char)((b) + 3), \
+                  (char)((b) + 4), (char)((b) + 3), -1, (char)((b) + 4))
+
+// Char k sits at bit 11 - (5k mod 8) of its word; mulhi by 2^(16 - shift)
+// is a per-lane right shift.
+static inline __m128i b32_fields(__m128i words) {
+    const __m128i shift = _mm_setr_epi16(1 << 5, 1 << 10, 1 << 7, 1 << 12,
+                                         1 << 9, 1 << 6, 1 << 11, 1 << 8);
+    return _mm_and_si128(_mm_mulhi_epu16(words, shift), _mm_set1_epi16(31));
+}
+
+// Values 0..31 -> 'a'-'z', '2'-'7'.
+static inline __m128i b32_chars(__m128i v) {
+    __m128i digit = _mm_cmpgt_epi8(v, _mm_set1_epi8(25));
+    return _mm_add_epi8(_mm_add_epi8(v, _mm_set1_epi8('a')),
+                        _mm_and_si128(digit, _mm_set1_epi8('2' - 'a' - 26)));
+}
+
+static inline __m128i b32_vals(__m128i c, __m128i *bad) {
+    __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+    __m128i is_alpha = range_sse2(lower, 'a', 'z');
+    __m128i is_digit = range_sse2(c, '2', '7');
+    *bad = _mm_or_si128(*bad, _mm_xor_si128(_mm_or_si128(is_alpha, is_digit), _mm_set1_epi8(-1)));
+    return _mm_or_si128(_mm_and_si128(_mm_sub_epi8(lower, _mm_set1_epi8('a')), is_alpha),
+                        _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('2' - 26)), is_digit));
+}
+
+// 16 values (two groups) -> two 40-bit big-endian groups in bytes 0-9.
+CT_TARGET_SSSE3
+static inline __m128i b32_join(__m128i v) {
+    __m128i w = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0120)); // 32 * v0 + v1
+    __m128i q = _mm_madd_epi16(w, _mm_set1_epi32(0x00010400)); // 1024 * w0 + w1
+    // 20 + 20 bits per 64-bit lane -> one 40-bit value.
+    q = _mm_or_si128(_mm_slli_epi64(_mm_and_si128(q, _mm_set_epi32(0, -1, 0, -1)), 20),
+                     _mm_srli_epi64(q, 32));
+    return _mm_shuffle_epi8(q, _mm_setr_epi8(4, 3, 2, 1, 0, 12, 11, 10, 9, 8,
+                                             -1, -1, -1, -1, -1, -1));
+}
+
+CT_TARGET_SSSE3
+void ct_b32_encode_ssse3(const uint8_t *d, size_t n, char *out) {
+    // Groups 0-5 are bytes 0-29; the tail (bytes 30-31, zero-extended) gives
+    // the last 4 chars. Loads stay inside the digest.
+    const __m128i g0 = B32_GATHER(0), g1 = B32_GATHER(5), g4 = B32_GATHER(4), g5 = B32_GATHER(9);
+    const __m128i tail = _mm_setr_epi8(15, 14, 15, 14, -1, 15, -1, 15,
+                                       -1, -1, -1, -1, -1, -1, -1, -1);
+    for (size_t i = 0; i < n; i++, d += CT_RESUME_HASH_LEN, out += CT_DIGEST_BASE32_LEN) {
+        __m128i lo = _mm_loadu_si128((const __m128i *)d);
+        __m128i mid = _mm_loadu_si128((const __m128i *)(d + 10));
+        __m128i hi = _mm_loadu_si128((const __m128i *)(d + 16));
+
+        __m128i c0 = _mm_packus_epi16(b32_fields(_mm_shuffle_epi8(lo, g0)),
+                                      b32_fields(_mm_shuffle_epi8(lo, g1)));
+        __m128i c1 = _mm_packus_epi16(b32_fields(_mm_shuffle_epi8(mid, g0)),
+                                      b32_fields(_mm_shuffle_epi8(mid, g1)));
+        __m128i c2 = _mm_packus_epi16(b32_fields(_mm_shuffle_epi8(hi, g4)),
+                                      b32_fields(_mm_shuffle_epi8(hi, g5)));
+        __m128i c3 = _mm_packus_epi16(b32_fields(_mm_shuffle_epi8(hi, tail)), _mm_setzero_si128());
+
+        _mm_storeu_si128((__m128i *)out, b32_chars(c0));
+        _mm_storeu_si128((__m128i *)(out + 16), b32_chars(c1));
+        _mm_storeu_si128((__m128i *)(out + 32), b32_chars(c2));
+        int last = _mm_cvtsi128_si32(b32_chars(c3));
+        memcpy(out + 48, &last, 4);
+    }
+}
+
+CT_TARGET_SSSE3
+uint32_t ct_b32_decode_ssse3(const char *in, size_t n, uint8_t *d) {
+    // Last block: chars 48-51 from a load ending at the string's end, padded
+    // with 'a' (value 0); the byte after the digest holds the padding bits.
+    const __m128i tail = _mm_setr_epi8(12, 13, 14, 15, -1, -1, -1, -1,
+                                       -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m128i fill = _mm_setr_epi8(0, 0, 0, 0, 'a', 'a', 'a', 'a',
+                                       'a', 'a', 'a', 'a', 'a', 'a', 'a', 'a');
+    __m128i bad = _mm_setzero_si128();
+    uint32_t pad = 0;
+    for (size_t i = 0; i < n; i++, in += CT_DIGEST_BASE32_LEN, d += CT_RESUME_HASH_LEN) {
+        __m128i b0 = b32_join(b32_vals(_mm_loadu_si128((const __m128i *)in), &bad));
+        __m128i b1 = b32_join(b32_vals(_mm_loadu_si128((const __m128i *)(in + 16)), &bad));
+        __m128i b2 = b32_join(b32_vals(_mm_loadu_si128((const __m128i *)(in + 32)), &bad));
+        __m128i c3 = _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 36)), tail),
+                                  fill);
+        __m128i b3 = b32_join(b32_vals(c3, &bad));
+
+        // Overlapping stores, in order, never past byte 31.
+        _mm_storeu_si128((__m128i *)d, b0);
+        _mm_storeu_si128((__m128i *)(d + 10), b1);
+        _mm_storel_epi64((__m128i *)(d + 20), b2);
+        uint32_t w = (uint32_t)_mm_extract_epi16(b2, 4);
+        d[28] = (uint8_t)w;
+        d[29] = (uint8_t)(w >> 8);
+        w = (uint32_t)_mm_extract_epi16(b3, 0);
+        d[30] = (uint8_t)w;
+        d[31] = (uint8_t)(w >> 8);
+        pad |= (uint32_t)_mm_extract_epi16(b3, 1) & 0xffu;
+    }
+    return (uint32_t)_mm_movemask_epi8(bad) | pad;
+}
+
+// ---- base64url: 3-byte groups -> 4 chars ----
+
+// Gathers four 3-byte groups b0 b1 b2 as [b1 b0 b2 b1] per 32-bit lane.
+#define B64_GATHER(p)                                                                     \
+    _mm_setr_epi8((char)((p) + 1), (char)(p), (char)((p) + 2), (char)((p) + 1),          \
+                  (char)((p) + 4), (char)((p) + 3), (char)((p) + 5), (char)((p) + 4),    \
+                  (char)((p) + 7), (char)((p) + 6), (char)((p) + 8), (char)((p) + 7),    \
+                  (char)((p) + 10), (char)((p) + 9), (char)((p) + 11), (char)((p) + 10))
+
+// Four 6-bit fields per lane, in output order (mask + multiply-shift).
+static inline __m128i b64_fields(__m128i x) {
+    __m128i a = _mm_mulhi_epu16(_mm_and_si128(x, _mm_set1_epi32(0x0fc0fc00)),
+                                _mm_set1_epi32(0x04000040));
+    __m128i b = _mm_mullo_epi16(_mm_and_si128(x, _mm_set1_epi32(0x003f03f0)),
+                                _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(a, b);
+}
+
+// Values 0..63 -> 'A'-'Z', 'a'-'z', '0'-'9', '-', '_'.
+static inline __m128i b64_chars(__m128i v) {
+    __m128i c = _mm_add_epi8(v, _mm_set1_epi8('A'));
+    c = _mm_add_epi8(c, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(25)),
+                                      _mm_set1_epi8(('a' - 26) - 'A')));
+    c = _mm_add_epi8(c, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(51)),
+                                      _mm_set1_epi8((char)(('0' - 52) - ('a' - 26)))));
+    c = _mm_add_epi8(c, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(61)),
+                                      _mm_set1_epi8((char)(('-' - 62) - ('0' - 52)))));
+    c = _mm_add_epi8(c, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(62)),
+                                      _mm_set1_epi8(('_' - 63) - ('-' - 62))));
+    return c;
+}
+
+static inline __m128i b64_vals(__m128i c, __m128i *bad) {
+    __m128i up = range_sse2(c, 'A', 'Z');
+    __m128i lo = range_sse2(c, 'a', 'z');
+    __m128i dg = range_sse2(c, '0', '9');
+    __m128i dash = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+    __m128i under = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+    __m128i ok = _mm_or_si128(_mm_or_si128(up, lo), _mm_or_si128(dg, _mm_or_si128(dash, under)));
+    *bad = _mm_or_si128(*bad, _mm_xor_si128(ok, _mm_set1_epi8(-1)));
+    __m128i v = _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('A')), up);
+    v = _mm_or_si128(v, _mm_and_si128(_mm_sub_epi8(c, _mm_set1_epi8('a' - 26)), lo));
+    v = _mm_or_si128(v, _mm_and_si128(_mm_add_epi8(c, _mm_set1_epi8(52 - '0')), dg));
+    v = _mm_or_si128(v, _mm_and_si128(_mm_set1_epi8(62), dash));
+    return _mm_or_si128(v, _mm_and_si128(_mm_set1_epi8(63), under));
+}
+
+// 16 values -> four 3-byte groups in bytes 0-11.
+CT_TARGET_SSSE3
+static inline __m128i b64_join(__m128i v) {
+    __m128i w = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0140)); // 64 * v0 + v1
+    __m128i q = _mm_madd_epi16(w, _mm_set1_epi32(0x00011000)); // 4096 * w0 + w1
+    return _mm_shuffle_epi8(q, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                             -1, -1, -1, -1));
+}
+
+CT_TARGET_SSSE3
+void ct_b64_encode_ssse3(const uint8_t *d, size_t n, char *out) {
+    // Bytes 0-11 and 12-23 give 16 chars each; bytes 24-31 plus a zero byte
+    // give the last 11 (the final char carries the 2 zero padding bits).
+    const __m128i g0 = B64_GATHER(0);
+    const __m128i tail = _mm_setr_epi8(9, 8, 10, 9, 12, 11, 13, 12, 15, 14, -1, 15,
+                                       -1, -1, -1, -1);
+    for (size_t i = 0; i < n; i++, d += CT_RESUME_HASH_LEN, out += CT_DIGEST_BASE64URL_LEN) {
+        __m128i c0 = b64_chars(b64_fields(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)d), g0)));
+        __m128i c1 = b64_chars(b64_fields(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(d + 12)), g0)));
+        __m128i c2 = b64_chars(b64_fields(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(d + 16)), tail)));
+
+        _mm_storeu_si128((__m128i *)out, c0);
+        _mm_storeu_si128((__m128i *)(out + 16), c1);
+        _mm_storel_epi64((__m128i *)(out + 32), c2);
+        uint32_t w = (uint32_t)_mm_extract_epi16(c2, 4);
+        out[40] = (char)w;
+        out[41] = (char)(w >> 8);
+        out[42] = (char)_mm_extract_epi16(c2, 5);
+    }
+}
+
+CT_TARGET_SSSE3
+uint32_t ct_b64_decode_ssse3(const char *in, size_t n, uint8_t *d) {
+    // Last block: chars 32-42 from a load ending at the string's end, padded
+    // with 'A' (value 0); byte 8 of its output holds the padding bits.
+    const __m128i tail = _mm_setr_epi8(5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                                       -1, -1, -1, -1, -1);
+    const __m128i fill = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 'A', 'A', 'A', 'A', 'A');
+    __m128i bad = _mm_setzero_si128();
+    uint32_t pad = 0;
+    for (size_t i = 0; i < n; i++, in += CT_DIGEST_BASE64URL_LEN, d += CT_RESUME_HASH_LEN) {
+        __m128i b0 = b64_join(b64_vals(_mm_loadu_si128((const __m128i *)in), &bad));
+        __m128i b1 = b64_join(b64_vals(_mm_loadu_si128((const __m128i *)(in + 16)), &bad));
+        __m128i c2 = _mm_or_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(in + 27)), tail),
+                                  fill);
+        __m128i b2 = b64_join(b64_vals(c2, &bad));
+
+        // Overlapping stores, in order, never past byte 31.
+        _mm_storeu_si128((__m128i *)d, b0);
+        _mm_storeu_si128((__m128i *)(d + 12), b1);
+        _mm_storel_epi64((__m128i *)(d + 24), b2);
+        pad |= (uint32_t)_mm_extract_epi16(b2, 4) & 0xffu;
+    }
+    return (uint32_t)_mm_movemask_epi8(bad) | pad;
+}
+
+// ---- comparisons ----
+
+// 1 if the 32 bytes at h equal the needle halves, else 0; no branches.
+static inline size_t eq_sse2(__m128i n0, __m128i n1, const uint8_t *h) {
+    __m128i x = _mm_or_si128(_mm_xor_si128(n0, _mm_loadu_si128((const __m128i *)h)),
+                             _mm_xor_si128(n1, _mm_loadu_si128((const __m128i *)(h + 16))));
+    uint32_t ne = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) ^ 0xffffu;
+    return (size_t)((ne - 1u) >> 31);
+}
+
+void ct_equal_batch_sse2(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq) {
+    __m128i n0 = _mm_loadu_si128((const __m128i *)needle);
+    __m128i n1 = _mm_loadu_si128((const __m128i *)(needle + 16));
+    for (size_t i = 0; i < n; i++) {
+        out_eq[i] = (uint8_t)eq_sse2(n0, n1, haystack + i * CT_RESUME_HASH_LEN);
+    }
+}
+
+size_t ct_find_sse2(const uint8_t *needle, const uint8_t *haystack, size_t n) {
+    __m128i n0 = _mm_loadu_si128((const __m128i *)needle);
+    __m128i n1 = _mm_loadu_si128((const __m128i *)(needle + 16));
+    size_t found = n;
+    size_t have = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t hit = (size_t)0 - eq_sse2(n0, n1, haystack + i * CT_RESUME_HASH_LEN);
+        size_t take = hit & ~have;
+        found = (found & ~take) | (i & take);
+        have |= hit;
+    }
+    return found;
+}
+
+CT_TARGET_AVX2
+static inline size_t eq_avx2(__m256i nd, const uint8_t *h) {
+    __m256i x = _mm256_xor_si256(nd, _mm256_loadu_si256((const __m256i *)h));
+    return (size_t)_mm256_testz_si256(x, x);
+}
+
+CT_TARGET_AVX2
+void ct_equal_batch_avx2(const uint8_t *needle, const uint8_t *haystack, size_t n, uint8_t *out_eq) {
+    __m256i nd = _mm256_loadu_si256((const __m256i *)needle);
+    for (size_t i = 0; i < n; i++) {
+        out_eq[i] = (uint8_t)eq_avx2(nd, haystack + i * CT_RESUME_HASH_LEN);
+    }
+}
+
+CT_TARGET_AVX2
+size_t ct_find_avx2(const uint8_t *needle, const uint8_t *haystack, size_t n) {
+    __m256i nd = _mm256_loadu_si256((const __m256i *)needle);
+    size_t found = n;
+    size_t have = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t hit = (size_t)0 - eq_avx2(nd, haystack + i * CT_RESUME_HASH_LEN);
+        size_t take = hit & ~have;
+        found = (found & ~take) | (i & take);
+        have |= hit;
+    }
+    return found;
+}
+
+#else
+
+// Keep the translation unit non-empty for -pedantic.
+typedef int ct_digest_simd_x86_unused;
+
+#endif // CT_DIGEST_SIMD_X86
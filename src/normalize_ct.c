@@ -1,4 +1,5 @@
 #include "ct_resume_hash.h"
+#include "cpu_dispatch.h"
 #include "normalize.h"
 
 #include <stddef.h>
@@ -15,6 +16,7 @@ static inline uint8_t ct_to_lower(uint8_t ch) {
     return (uint8_t)(ch ^ (mask & 0x20));
 }
 
+CT_HOT_KERNEL
 size_t ct_normalize_ascii_ct(const uint8_t *in,
                              size_t in_len,
                              uint8_t *out,
@@ -0,0 +1,330 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ct_resume_hash.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+// Submission/completion pool: a FIFO of jobs drained by worker threads and a
+// FIFO of completions drained by the caller. The completion fd is readable
+// whenever the completion queue may be non-empty (eventfd on Linux, a
+// self-pipe elsewhere), so it can be registered with an event loop.
+
+typedef struct pool_done {
+    struct pool_done *next;
+    ct_resume_hash_completion c;
+} pool_done;
+
+// The completion node is allocated at submit time so a finished job can
+// always be reported; workers never allocate.
+typedef struct pool_job {
+    struct pool_job *next;
+    pool_done *done;
+    size_t len;
+    uint8_t data[];
+} pool_job;
+
+struct ct_resume_hash_pool {
+    pthread_mutex_t lock;
+    pthread_cond_t jobs_cv;
+    pool_job *jobs_head;
+    pool_job *jobs_tail;
+    pool_done *done_head;
+    pool_done *done_tail;
+    int shutdown;
+
+    size_t inline_max;
+    int notify_rd;
+    int notify_wr;
+
+    size_t n_workers;
+    pthread_t *workers;
+};
+
+static void notify_signal(ct_resume_hash_pool *pool) {
+    // eventfd takes an 8-byte counter increment; a pipe just gets 8 bytes.
+    // EAGAIN means the fd is already readable, which is all we need.
+    uint64_t one = 1;
+    ssize_t n = write(pool->notify_wr, &one, sizeof(one));
+    (void)n;
+}
+
+static void notify_drain(ct_resume_hash_pool *pool) {
+    uint8_t sink[64];
+    while (read(pool->notify_rd, sink, sizeof(sink)) > 0) {
+    }
+}
+
+static int notify_open(ct_resume_hash_pool *pool) {
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    pool->notify_rd = fd;
+    pool->notify_wr = fd;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    pool->notify_rd = fds[0];
+    pool->notify_wr = fds[1];
+#endif
+    return 0;
+}
+
+static void notify_close(ct_resume_hash_pool *pool) {
+    if (pool->notify_rd >= 0) {
+        close(pool->notify_rd);
+    }
+    if (pool->notify_wr >= 0 && pool->notify_wr != pool->notify_rd) {
+        close(pool->notify_wr);
+    }
+}
+
+static void push_done(ct_resume_hash_pool *pool, pool_done *done) {
+    pthread_mutex_lock(&pool->lock);
+    done->next = NULL;
+    if (pool->done_tail) {
+        pool->done_tail->next = done;
+    } else {
+        pool->done_head = done;
+    }
+    pool->done_tail = done;
+    pthread_mutex_unlock(&pool->lock);
+    notify_signal(pool);
+}
+
+static void free_job(pool_job *job) {
+    memset(job->data, 0, job->len);
+    free(job);
+}
+
+static void *worker_main(void *arg) {
+    ct_resume_hash_pool *pool = (ct_resume_hash_pool *)arg;
+
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->jobs_head && !pool->shutdown) {
+            pthread_cond_wait(&pool->jobs_cv, &pool->lock);
+        }
+        if (!pool->jobs_head) {
+            pthread_mutex_unlock(&pool->lock);
+            return NULL;
+        }
+        pool_job *job = pool->jobs_head;
+        pool->jobs_head = job->next;
+        if (!pool->jobs_head) {
+            pool->jobs_tail = NULL;
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        pool_done *done = job->done;
+        done->c.rc = ct_resume_hash_once(job->data, job->len, done->c.digest);
+        free_job(job);
+        push_done(pool, done);
+    }
+}
+
+ct_resume_hash_pool *ct_resume_hash_pool_new(size_t n_workers, size_t inline_max) {
+    if (n_workers == 0) {
+        return NULL;
+    }
+
+    ct_resume_hash_pool *pool = (ct_resume_hash_pool *)calloc(1, sizeof(ct_resume_hash_pool));
+    if (!pool) {
+        return NULL;
+    }
+    pool->inline_max = inline_max;
+    pool->notify_rd = -1;
+    pool->notify_wr = -1;
+
+    pool->workers = (pthread_t *)calloc(n_workers, sizeof(pthread_t));
+    if (!pool->workers || notify_open(pool) != 0) {
+        notify_close(pool);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->jobs_cv, NULL);
+
+    for (size_t i = 0; i < n_workers; i++) {
+        if (pthread_create(&pool->workers[i], NULL, worker_main, pool) != 0) {
+            break;
+        }
+        pool->n_workers++;
+    }
+    if (pool->n_workers == 0) {
+        ct_resume_hash_pool_free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void ct_resume_hash_pool_free(ct_resume_hash_pool *pool) {
+    if (!pool) {
+        return;
+    }
+
+    // Workers finish every queued job before exiting.
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    pthread_cond_broadcast(&pool->jobs_cv);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->n_workers; i++) {
+        pthread_join(pool->workers[i], NULL);
+    }
+
+    while (pool->done_head) {
+        pool_done *done = pool->done_head;
+        pool->done_head = done->next;
+        memset(done, 0, sizeof(*done));
+        free(done);
+    }
+
+    pthread_cond_destroy(&pool->jobs_cv);
+    pthread_mutex_destroy(&pool->lock);
+    notify_close(pool);
+    free(pool->workers);
+    free(pool);
+}
+
+int ct_resume_hash_pool_submit(ct_resume_hash_pool *pool,
+                               const uint8_t *input,
+                               size_t input_len,
+                               uint64_t tag,
+                               uint8_t inline_out[CT_RESUME_HASH_LEN]) {
+    if (!pool || !input) {
+        return -1;
+    }
+
+    if (input_len <= pool->inline_max) {
+        if (inline_out) {
+            int rc = ct_resume_hash_once(input, input_len, inline_out);
+            return rc == 0 ? 1 : rc;
+        }
+        pool_done *done = (pool_done *)calloc(1, sizeof(pool_done));
+        if (!done) {
+            return -2;
+        }
+        done->c.tag = tag;
+        done->c.rc = ct_resume_hash_once(input, input_len, done->c.digest);
+        push_done(pool, done);
+        return 0;
+    }
+
+    if (input_len > SIZE_MAX - sizeof(pool_job)) {
+        return -2;
+    }
+    pool_job *job = (pool_job *)malloc(sizeof(pool_job) + input_len);
+    pool_done *done = (pool_done *)calloc(1, sizeof(pool_done));
+    if (!job || !done) {
+        free(job);
+        free(done);
+        return -2;
+    }
+    done->c.tag = tag;
+    job->next = NULL;
+    job->done = done;
+    job->len = input_len;
+    memcpy(job->data, input, input_len);
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->jobs_tail) {
+        pool->jobs_tail->next = job;
+    } else {
+        pool->jobs_head = job;
+    }
+    pool->jobs_tail = job;
+    pthread_cond_signal(&pool->jobs_cv);
+    pthread_mutex_unlock(&pool->lock);
+    return 0;
+}
+
+int ct_resume_hash_pool_fd(const ct_resume_hash_pool *pool) {
+    return pool ? pool->notify_rd : -1;
+}
+
+size_t ct_resume_hash_pool_poll(ct_resume_hash_pool *pool,
+                                ct_resume_hash_completion *out,
+                                size_t max) {
+    if (!pool || !out) {
+        return 0;
+    }
+
+    size_t n = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (n < max && pool->done_head) {
+        pool_done *done = pool->done_head;
+        pool->done_head = done->next;
+        out[n++] = done->c;
+        memset(done, 0, sizeof(*done));
+        free(done);
+    }
+    if (!pool->done_head) {
+        pool->done_tail = NULL;
+        // Reset under the lock: any later push re-signals after we unlock.
+        notify_drain(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return n;
+}
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+size_t ct_resume_hash_pool_wait(ct_resume_hash_pool *pool,
+                                ct_resume_hash_completion *out,
+                                size_t max,
+                                int timeout_ms) {
+    if (!pool || !out || max == 0) {
+        return 0;
+    }
+
+    // A wakeup does not guarantee a completion: the fd may carry a stale
+    // signal, or another thread may drain the queue first. Keep polling
+    // until something arrives or the deadline passes.
+    int64_t deadline = timeout_ms >= 0 ? monotonic_ms() + timeout_ms : 0;
+    for (;;) {
+        size_t n = ct_resume_hash_pool_poll(pool, out, max);
+        if (n > 0) {
+            return n;
+        }
+
+        int remaining = -1;
+        if (timeout_ms >= 0) {
+            int64_t left = deadline - monotonic_ms();
+            if (left <= 0) {
+                return 0;
+            }
+            remaining = (int)left;
+        }
+
+        struct pollfd pfd;
+        pfd.fd = pool->notify_rd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (poll(&pfd, 1, remaining) < 0 && errno != EINTR) {
+            return 0;
+        }
+    }
+}
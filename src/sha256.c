@@ -1,4 +1,5 @@
 #include "sha256.h"
+#include "cpu_dispatch.h"
 
 #include <string.h>
 
@@ -21,6 +22,9 @@ static uint32_t sig1(uint32_t x) { return rotr(x, 6) ^ rotr(x, 11) ^ rotr(x, 25)
 static uint32_t theta0(uint32_t x) { return rotr(x, 7) ^ rotr(x, 18) ^ (x >> 3); }
 static uint32_t theta1(uint32_t x) { return rotr(x, 17) ^ rotr(x, 19) ^ (x >> 10); }
 
+// The compression function is where the time goes; clone it rather than the
+// buffering loop in ct_sha256_update.
+CT_HOT_KERNEL
 static void process_block(ct_sha256_ctx *ctx, const uint8_t block[64]) {
     uint32_t w[64];
     for (size_t i = 0; i < 16; i++) {
@@ -0,0 +1,252 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include "ct_resume_hash.h"
+#include "hash_core.h"
+#include "normalize.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Differential harness: every normalizer, hash path and API shape must agree
+// on the same input. Any mismatch traps. Shapes that take longer than the
+// slow-unit budget are reported on stderr and, if CT_FUZZ_SLOW_DIR is set,
+// the input is written there for replay.
+
+#define SLOW_NS_BASE 5000000ull   // fixed allowance per shape
+#define SLOW_NS_PER_BYTE 200ull   // plus this much per input byte
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t fnv1a64(const uint8_t *data, size_t size) {
+    uint64_t h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        h ^= data[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static uint64_t splitmix64(uint64_t *state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+static void check(int ok) {
+    if (!ok) {
+        __builtin_trap();
+    }
+}
+
+// ---- API shapes: each fills `out` with the digest of the raw input ----
+
+typedef int (*shape_fn)(const uint8_t *data, size_t size, uint64_t seed,
+                        uint8_t out[CT_RESUME_HASH_LEN]);
+
+static int shape_once(const uint8_t *data, size_t size, uint64_t seed,
+                      uint8_t out[CT_RESUME_HASH_LEN]) {
+    (void)seed;
+    return ct_resume_hash_once(data, size, out);
+}
+
+static int shape_stream_random(const uint8_t *data, size_t size, uint64_t seed,
+                               uint8_t out[CT_RESUME_HASH_LEN]) {
+    ct_resume_hash_ctx *ctx = ct_resume_hash_new();
+    if (!ctx) {
+        return -2;
+    }
+    size_t off = 0;
+    while (off < size) {
+        // Mix of tiny, mid and large chunks, including zero-length updates.
+        uint64_t r = splitmix64(&seed);
+        size_t cap = (r & 3u) == 0 ? 4096u : ((r & 3u) == 1 ? 64u : 3u);
+        size_t take = (size_t)((r >> 8) % (cap + 1u));
+        if (take > size - off) {
+            take = size - off;
+        }
+        if (ct_resume_hash_update(ctx, data + off, take) != 0) {
+            ct_resume_hash_free(ctx);
+            return -2;
+        }
+        off += take;
+    }
+    int rc = ct_resume_hash_final(ctx, out);
+    ct_resume_hash_free(ctx);
+    return rc;
+}
+
+static int shape_cache_hit(const uint8_t *data, size_t size, uint64_t seed,
+                           uint8_t out[CT_RESUME_HASH_LEN]) {
+    (void)seed;
+    uint8_t first[CT_RESUME_HASH_LEN];
+    if (ct_resume_hash_cache_enable(64u * 1024u * 1024u) != 0) {
+        return -2;
+    }
+    int rc = ct_resume_hash_once(data, size, first);
+    if (rc == 0) {
+        rc = ct_resume_hash_once(data, size, out);
+    }
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+    ct_resume_hash_cache_disable();
+    check(rc != 0 || memcmp(first, out, CT_RESUME_HASH_LEN) == 0);
+    check(rc != 0 || stats.insertions == 0 || stats.hits == 1);
+    return rc;
+}
+
+// Same input submitted twice through the worker pool (inline path disabled)
+// and once through the inline fast path; all three must agree.
+static int shape_pool(const uint8_t *data, size_t size, uint64_t seed,
+                      uint8_t out[CT_RESUME_HASH_LEN]) {
+    static ct_resume_hash_pool *pool;
+    static ct_resume_hash_pool *inline_pool;
+    if (!pool) {
+        pool = ct_resume_hash_pool_new(2, 0);
+        inline_pool = ct_resume_hash_pool_new(1, SIZE_MAX);
+        if (!pool || !inline_pool) {
+            return -2;
+        }
+    }
+
+    if (ct_resume_hash_pool_submit(pool, data, size, seed, NULL) != 0 ||
+        ct_resume_hash_pool_submit(pool, data, size, seed + 1u, NULL) != 0) {
+        return -2;
+    }
+    ct_resume_hash_completion done[2];
+    size_t got = 0;
+    while (got < 2) {
+        got += ct_resume_hash_pool_wait(pool, done + got, 2 - got, -1);
+    }
+    check(done[0].rc == 0 && done[1].rc == 0);
+    check(memcmp(done[0].digest, done[1].digest, CT_RESUME_HASH_LEN) == 0);
+
+    check(ct_resume_hash_pool_submit(inline_pool, data, size, seed, out) == 1);
+    check(memcmp(out, done[0].digest, CT_RESUME_HASH_LEN) == 0);
+    return 0;
+}
+
+static const struct {
+    const char *name;
+    shape_fn fn;
+} shapes[] = {
+    {"once", shape_once},
+    {"stream_random", shape_stream_random},
+    {"cache_hit", shape_cache_hit},
+    {"pool", shape_pool},
+};
+
+#define N_SHAPES (sizeof(shapes) / sizeof(shapes[0]))
+
+static void record_slow_unit(const char *what, const uint8_t *data, size_t size,
+                             uint64_t elapsed, uint64_t unit_id) {
+    fprintf(stderr, "fuzz_differential: slow unit %016llx shape=%s size=%zu elapsed=%.3f ms\n",
+            (unsigned long long)unit_id, what, size, (double)elapsed / 1e6);
+
+    const char *dir = getenv("CT_FUZZ_SLOW_DIR");
+    if (!dir) {
+        return;
+    }
+    char path[4096];
+    snprintf(path, sizeof(path), "%s/slow-%s-%016llx", dir, what, (unsigned long long)unit_id);
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return;
+    }
+    fwrite(data, 1, size, f);
+    fclose(f);
+}
+
+static void time_check(const char *what, uint64_t start, const uint8_t *data,
+                       size_t size, uint64_t unit_id) {
+    uint64_t elapsed = now_ns() - start;
+    if (elapsed > SLOW_NS_BASE + SLOW_NS_PER_BYTE * (uint64_t)size) {
+        record_slow_unit(what, data, size, elapsed, unit_id);
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    uint64_t unit_id = fnv1a64(data, size);
+
+    uint8_t *norm_ref = (uint8_t *)malloc(size + 2);
+    uint8_t *norm_ct = (uint8_t *)malloc(size + 2);
+    uint8_t *norm_pub = (uint8_t *)malloc(size + 2);
+    if (!norm_ref || !norm_ct || !norm_pub) {
+        free(norm_ref);
+        free(norm_ct);
+        free(norm_pub);
+        return 0;
+    }
+
+    // Normalizers: reference, constant-time and the build-selected public one.
+    uint64_t start = now_ns();
+    size_t ref_len = ct_normalize_ascii_ref(data, size, norm_ref, size + 2);
+    time_check("normalize_ref", start, data, size, unit_id);
+
+    start = now_ns();
+    size_t ct_len = ct_normalize_ascii_ct(data, size, norm_ct, size + 2);
+    time_check("normalize_ct", start, data, size, unit_id);
+
+    size_t pub_len = ct_normalize_ascii(data, size, norm_pub, size + 2);
+
+    check(ref_len <= size);
+    check(ref_len == ct_len && memcmp(norm_ref, norm_ct, ref_len) == 0);
+    check(ref_len == pub_len && memcmp(norm_ref, norm_pub, ref_len) == 0);
+
+    // Hash core on the normalized bytes is the oracle for every API shape.
+    uint8_t expected[CT_RESUME_HASH_LEN];
+    check(ct_hash_core_once(norm_ref, ref_len, expected) == 0);
+
+    for (size_t i = 0; i < N_SHAPES; i++) {
+        uint8_t out[CT_RESUME_HASH_LEN];
+        start = now_ns();
+        int rc = shapes[i].fn(data, size, unit_id, out);
+        time_check(shapes[i].name, start, data, size, unit_id);
+        check(rc == 0);
+        check(memcmp(out, expected, CT_RESUME_HASH_LEN) == 0);
+    }
+
+    free(norm_ref);
+    free(norm_ct);
+    free(norm_pub);
+    return 0;
+}
+
+#if !defined(__AFL_LOOP) && !defined(LIBFUZZER)
+// Standalone smoke run: fixed seeds plus pseudo-random inputs of varied size.
+int main(void) {
+    static const char *seeds[] = {
+        "",
+        " ",
+        "Hello\nWorld",
+        "  Senior ENGINEER\twith\n   spacing   and CAPS   ",
+        "CTRL\x01\x02" "abc\x7f\xff",
+        "UTF8 \xc3\xa1\xc3\xa9\xc3\xad",
+    };
+    for (size_t i = 0; i < sizeof(seeds) / sizeof(seeds[0]); i++) {
+        LLVMFuzzerTestOneInput((const uint8_t *)seeds[i], strlen(seeds[i]));
+    }
+
+    static uint8_t buf[1u << 16];
+    uint64_t state = 0x5eedull;
+    for (size_t iter = 0; iter < 200; iter++) {
+        size_t len = (size_t)(splitmix64(&state) % (iter < 150 ? 512u : sizeof(buf)));
+        for (size_t j = 0; j < len; j++) {
+            // Bias towards whitespace, letters and high bytes.
+            uint64_t r = splitmix64(&state);
+            static const uint8_t alphabet[] = " \t\n\r\fAaZz?~\x01\x1f\x7f\x80\xff";
+            buf[j] = (r & 1u) ? alphabet[(r >> 1) % (sizeof(alphabet) - 1u)] : (uint8_t)(r >> 8);
+        }
+        LLVMFuzzerTestOneInput(buf, len);
+    }
+    return 0;
+}
+#endif
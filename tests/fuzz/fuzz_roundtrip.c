@@ -2,6 +2,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <string.h>
 
 int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
@@ -15,11 +16,16 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     const uint8_t *b = data + mid;
     size_t b_len = size - mid;
 
-    uint8_t norm_a[1024];
-    uint8_t norm_b[1024];
+    uint8_t *norm_a = (uint8_t *)malloc(a_len + 2);
+    uint8_t *norm_b = (uint8_t *)malloc(b_len + 2);
+    if (!norm_a || !norm_b) {
+        free(norm_a);
+        free(norm_b);
+        return 0;
+    }
 
-    size_t norm_a_len = ct_normalize_ascii(a, a_len, norm_a, sizeof(norm_a));
-    size_t norm_b_len = ct_normalize_ascii(b, b_len, norm_b, sizeof(norm_b));
+    size_t norm_a_len = ct_normalize_ascii(a, a_len, norm_a, a_len + 2);
+    size_t norm_b_len = ct_normalize_ascii(b, b_len, norm_b, b_len + 2);
 
     uint8_t hash_a[CT_RESUME_HASH_LEN];
     uint8_t hash_b[CT_RESUME_HASH_LEN];
@@ -31,6 +37,8 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     if (same_norm && memcmp(hash_a, hash_b, CT_RESUME_HASH_LEN) != 0) {
         __builtin_trap();
     }
+    free(norm_a);
+    free(norm_b);
     return 0;
 }
 
@@ -1,3 +1,5 @@
+#define _POSIX_C_SOURCE 199309L
+
 #include "ct_resume_hash.h"
 
 #include <stdint.h>
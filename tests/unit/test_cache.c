@@ -0,0 +1,116 @@
+#include "ct_resume_hash.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+static const uint8_t hello_world[CT_RESUME_HASH_LEN] = {
+    0xb9, 0x4d, 0x27, 0xb9, 0x93, 0x4d, 0x3e, 0x08,
+    0xa5, 0x2e, 0x52, 0xd7, 0xda, 0x7d, 0xab, 0xfa,
+    0xc4, 0x84, 0xef, 0xe3, 0x7a, 0x53, 0x80, 0xee,
+    0x90, 0x88, 0xf7, 0xac, 0xe2, 0xef, 0xcd, 0xe9};
+
+static void check_disabled_by_default(void) {
+    const char *input = "Hello\nWorld";
+    uint8_t out[CT_RESUME_HASH_LEN];
+    int rc = ct_resume_hash_once((const uint8_t *)input, strlen(input), out);
+    assert(rc == 0);
+
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+    assert(stats.hits == 0 && stats.misses == 0 && stats.entries == 0);
+    rc = ct_resume_hash_cache_enable(0);
+    assert(rc != 0);
+    rc = ct_resume_hash_cache_enable(15);
+    assert(rc != 0);
+    rc = ct_resume_hash_cache_enable(CT_RESUME_HASH_CACHE_MIN_BYTES - 1u);
+    assert(rc != 0);
+}
+
+static void check_hit_and_verify(void) {
+    const char *input = "Hello\nWorld";
+    uint8_t out[CT_RESUME_HASH_LEN];
+
+    int rc = ct_resume_hash_cache_enable(1u << 20);
+    assert(rc == 0);
+    for (int i = 0; i < 3; i++) {
+        rc = ct_resume_hash_once((const uint8_t *)input, strlen(input), out);
+        assert(rc == 0);
+        assert(memcmp(out, hello_world, CT_RESUME_HASH_LEN) == 0);
+    }
+
+    // Same length, different bytes: must not be served from the cache.
+    const char *other = "Hello\nWorlD";
+    uint8_t other_out[CT_RESUME_HASH_LEN];
+    rc = ct_resume_hash_once((const uint8_t *)other, strlen(other), other_out);
+    assert(rc == 0);
+    assert(memcmp(other_out, hello_world, CT_RESUME_HASH_LEN) == 0);
+    const char *distinct = "Hello\nWorlx";
+    rc = ct_resume_hash_once((const uint8_t *)distinct, strlen(distinct), other_out);
+    assert(rc == 0);
+    assert(memcmp(other_out, hello_world, CT_RESUME_HASH_LEN) != 0);
+
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+    assert(stats.hits == 2);
+    assert(stats.misses == 3);
+    assert(stats.insertions == 3);
+    assert(stats.entries == 3);
+    assert(stats.bytes <= stats.max_bytes);
+
+    ct_resume_hash_cache_disable();
+    ct_resume_hash_cache_get_stats(&stats);
+    assert(stats.entries == 0 && stats.bytes == 0 && stats.hits == 0);
+}
+
+static void check_eviction_respects_cap(void) {
+    // 16 shards share the budget; use the minimum so eviction kicks in.
+    int rc = ct_resume_hash_cache_enable(CT_RESUME_HASH_CACHE_MIN_BYTES);
+    assert(rc == 0);
+
+    char input[64];
+    uint8_t out[CT_RESUME_HASH_LEN];
+    for (int i = 0; i < 4000; i++) {
+        int n = snprintf(input, sizeof(input), "resume number %d", i);
+        rc = ct_resume_hash_once((const uint8_t *)input, (size_t)n, out);
+        assert(rc == 0);
+    }
+
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+    assert(stats.evictions > 0);
+    assert(stats.bytes <= stats.max_bytes);
+    assert(stats.entries == stats.insertions - stats.evictions);
+
+    ct_resume_hash_cache_disable();
+}
+
+static void check_oversized_not_cached(void) {
+    int rc = ct_resume_hash_cache_enable(CT_RESUME_HASH_CACHE_MIN_BYTES);
+    assert(rc == 0);
+
+    // Larger than one shard's slice: hashed normally, never inserted.
+    static uint8_t big[CT_RESUME_HASH_CACHE_MIN_BYTES / 8u];
+    memset(big, 'r', sizeof(big));
+    uint8_t out[CT_RESUME_HASH_LEN];
+    for (int i = 0; i < 2; i++) {
+        rc = ct_resume_hash_once(big, sizeof(big), out);
+        assert(rc == 0);
+    }
+
+    ct_resume_hash_cache_stats stats;
+    ct_resume_hash_cache_get_stats(&stats);
+    assert(stats.misses == 2 && stats.hits == 0);
+    assert(stats.insertions == 0 && stats.entries == 0);
+
+    ct_resume_hash_cache_disable();
+}
+
+int main(void) {
+    check_disabled_by_default();
+    check_hit_and_verify();
+    check_eviction_respects_cap();
+    check_oversized_not_cached();
+    printf("test_cache: ok\n");
+    return 0;
+}
@@ -0,0 +1,274 @@
+#include "ct_resume_hash.h"
+#include "digest_simd.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+// hash("Hello\nWorld") and bytes 0xe0..0xff, with encodings from Python's
+// binascii/base64 as the reference.
+static const uint8_t digests[2][CT_RESUME_HASH_LEN] = {
+    {0xb9, 0x4d, 0x27, 0xb9, 0x93, 0x4d, 0x3e, 0x08,
+     0xa5, 0x2e, 0x52, 0xd7, 0xda, 0x7d, 0xab, 0xfa,
+     0xc4, 0x84, 0xef, 0xe3, 0x7a, 0x53, 0x80, 0xee,
+     0x90, 0x88, 0xf7, 0xac, 0xe2, 0xef, 0xcd, 0xe9},
+    {0xe0, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7,
+     0xe8, 0xe9, 0xea, 0xeb, 0xec, 0xed, 0xee, 0xef,
+     0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+     0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff}};
+
+static const char *hex =
+    "b94d27b9934d3e08a52e52d7da7dabfac484efe37a5380ee9088f7ace2efcde9"
+    "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+static const char *base32 =
+    "xfgspomtju7arjjokll5u7nl7lcij37dpjjyb3uqrd32zyxpzxuq"
+    "4dq6fy7e4xtop2hj5lv6z3po57ypd4xt6t27n57y7h5px7h5737q";
+static const char *base64url =
+    "uU0nuZNNPgilLlLX2n2r-sSE7-N6U4DukIj3rOLvzek"
+    "4OHi4-Tl5ufo6err7O3u7_Dx8vP09fb3-Pn6-_z9_v8";
+
+static void check_roundtrip(ct_digest_encoding enc, const char *expected) {
+    size_t len = ct_digest_encoded_len(enc);
+    assert(len * 2 == strlen(expected));
+
+    char text[2 * CT_DIGEST_HEX_LEN];
+    int rc = ct_digest_encode(enc, &digests[0][0], 2, text);
+    assert(rc == 0);
+    assert(memcmp(text, expected, 2 * len) == 0);
+
+    uint8_t back[2][CT_RESUME_HASH_LEN];
+    rc = ct_digest_decode(enc, expected, 2, &back[0][0]);
+    assert(rc == 0);
+    assert(memcmp(back, digests, sizeof(back)) == 0);
+
+    // Invalid character anywhere fails the whole batch.
+    memcpy(text, expected, 2 * len);
+    text[len + 3] = '!';
+    rc = ct_digest_decode(enc, text, 2, &back[0][0]);
+    assert(rc != 0);
+}
+
+static void check_decode_rules(void) {
+    uint8_t out[CT_RESUME_HASH_LEN];
+    char text[CT_DIGEST_HEX_LEN];
+
+    // Hex and base32 decoding accept upper case.
+    for (size_t i = 0; i < CT_DIGEST_HEX_LEN; i++) {
+        char c = hex[i];
+        text[i] = (c >= 'a' && c <= 'f') ? (char)(c - 32) : c;
+    }
+    int rc = ct_digest_decode(CT_DIGEST_HEX, text, 1, out);
+    assert(rc == 0);
+    assert(memcmp(out, digests[0], CT_RESUME_HASH_LEN) == 0);
+
+    for (size_t i = 0; i < CT_DIGEST_BASE32_LEN; i++) {
+        char c = base32[i];
+        text[i] = (c >= 'a' && c <= 'z') ? (char)(c - 32) : c;
+    }
+    rc = ct_digest_decode(CT_DIGEST_BASE32, text, 1, out);
+    assert(rc == 0);
+    assert(memcmp(out, digests[0], CT_RESUME_HASH_LEN) == 0);
+
+    // Non-zero trailing bits are not canonical.
+    memcpy(text, base32, CT_DIGEST_BASE32_LEN);
+    text[CT_DIGEST_BASE32_LEN - 1] = 'r';
+    rc = ct_digest_decode(CT_DIGEST_BASE32, text, 1, out);
+    assert(rc != 0);
+    memcpy(text, base64url, CT_DIGEST_BASE64URL_LEN);
+    text[CT_DIGEST_BASE64URL_LEN - 1] = 'l';
+    rc = ct_digest_decode(CT_DIGEST_BASE64URL, text, 1, out);
+    assert(rc != 0);
+
+    // Standard base64 characters are not base64url.
+    memcpy(text, base64url, CT_DIGEST_BASE64URL_LEN);
+    text[10] = '+';
+    rc = ct_digest_decode(CT_DIGEST_BASE64URL, text, 1, out);
+    assert(rc != 0);
+}
+
+static void check_compare(void) {
+    uint8_t haystack[5][CT_RESUME_HASH_LEN];
+    for (size_t i = 0; i < 5; i++) {
+        memcpy(haystack[i], digests[1], CT_RESUME_HASH_LEN);
+    }
+    haystack[1][31] ^= 1;
+    memcpy(haystack[2], digests[0], CT_RESUME_HASH_LEN);
+    memcpy(haystack[4], digests[0], CT_RESUME_HASH_LEN);
+
+    assert(ct_digest_equal(digests[0], haystack[2]) == 1);
+    assert(ct_digest_equal(digests[1], haystack[1]) == 0);
+
+    uint8_t eq[5];
+    ct_digest_equal_batch(digests[0], &haystack[0][0], 5, eq);
+    const uint8_t expected_eq[5] = {0, 0, 1, 0, 1};
+    assert(memcmp(eq, expected_eq, 5) == 0);
+
+    assert(ct_digest_find(digests[0], &haystack[0][0], 5) == 2);
+    assert(ct_digest_find(digests[1], &haystack[0][0], 5) == 0);
+    haystack[0][0] ^= 0x80;
+    haystack[3][16] ^= 0x80;
+    assert(ct_digest_find(digests[1], &haystack[0][0], 5) == 5);
+    assert(ct_digest_find(digests[1], &haystack[0][0], 0) == 0);
+}
+
+static void check_truncate(void) {
+    uint8_t short16[2][CT_DIGEST_SHORT128_LEN];
+    int rc = ct_digest_truncate(&digests[0][0], 2, CT_DIGEST_SHORT128_LEN, &short16[0][0]);
+    assert(rc == 0);
+    assert(memcmp(short16[1], digests[1], CT_DIGEST_SHORT128_LEN) == 0);
+
+    uint8_t short8[2][CT_DIGEST_SHORT64_LEN];
+    rc = ct_digest_truncate(&digests[0][0], 2, CT_DIGEST_SHORT64_LEN, &short8[0][0]);
+    assert(rc == 0);
+    assert(memcmp(short8[0], digests[0], CT_DIGEST_SHORT64_LEN) == 0);
+    rc = ct_digest_truncate(&digests[0][0], 2, 12, &short8[0][0]);
+    assert(rc != 0);
+
+    assert(ct_digest_short64(digests[0]) == 0xb94d27b9934d3e08ull);
+}
+
+// ---- bulk checks against a bit-at-a-time reference ----
+
+#define MAX_DIGESTS 40
+
+static uint64_t rng_state = 0x9e3779b97f4a7c15ull;
+
+static uint8_t rng_byte(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return (uint8_t)(rng_state >> 24);
+}
+
+// MSB-first bit groups of `bits` each, zero-padded at the end.
+static void ref_encode(ct_digest_encoding enc, const uint8_t *d, size_t n, char *out) {
+    static const char hex_alpha[] = "0123456789abcdef";
+    static const char b32_alpha[] = "abcdefghijklmnopqrstuvwxyz234567";
+    static const char b64_alpha[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    const char *alpha = enc == CT_DIGEST_HEX ? hex_alpha : enc == CT_DIGEST_BASE32 ? b32_alpha : b64_alpha;
+    unsigned bits = enc == CT_DIGEST_HEX ? 4 : enc == CT_DIGEST_BASE32 ? 5 : 6;
+    size_t len = ct_digest_encoded_len(enc);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t k = 0; k < len; k++) {
+            unsigned v = 0;
+            for (unsigned b = 0; b < bits; b++) {
+                size_t bit = k * bits + b;
+                unsigned x = bit < 8 * CT_RESUME_HASH_LEN
+                                 ? (d[i * CT_RESUME_HASH_LEN + bit / 8] >> (7 - bit % 8)) & 1u
+                                 : 0;
+                v = (v << 1) | x;
+            }
+            out[i * len + k] = alpha[v];
+        }
+    }
+}
+
+static void check_bulk(void) {
+    static uint8_t d[MAX_DIGESTS][CT_RESUME_HASH_LEN];
+    static uint8_t back[MAX_DIGESTS][CT_RESUME_HASH_LEN];
+    static char text[MAX_DIGESTS * CT_DIGEST_HEX_LEN];
+    static char want[MAX_DIGESTS * CT_DIGEST_HEX_LEN];
+    const ct_digest_encoding encs[3] = {CT_DIGEST_HEX, CT_DIGEST_BASE32, CT_DIGEST_BASE64URL};
+
+    for (size_t n = 0; n <= MAX_DIGESTS; n++) {
+        for (size_t i = 0; i < n * CT_RESUME_HASH_LEN; i++) {
+            d[i / CT_RESUME_HASH_LEN][i % CT_RESUME_HASH_LEN] = rng_byte();
+        }
+        for (size_t e = 0; e < 3; e++) {
+            size_t len = n * ct_digest_encoded_len(encs[e]);
+            ref_encode(encs[e], &d[0][0], n, want);
+            int rc = ct_digest_encode(encs[e], &d[0][0], n, text);
+            assert(rc == 0);
+            assert(memcmp(text, want, len) == 0);
+            rc = ct_digest_decode(encs[e], want, n, &back[0][0]);
+            assert(rc == 0);
+            assert(memcmp(back, d, n * CT_RESUME_HASH_LEN) == 0);
+        }
+    }
+}
+
+// Every byte value at every position of a 3-digest batch must be accepted or
+// rejected exactly as the scalar decoder does, with the same output.
+static void check_decode_matches_scalar(int isa) {
+    enum { N = 3 };
+    uint8_t d[N][CT_RESUME_HASH_LEN];
+    uint8_t got[N][CT_RESUME_HASH_LEN];
+    uint8_t ref[N][CT_RESUME_HASH_LEN];
+    char text[N * CT_DIGEST_HEX_LEN];
+    const ct_digest_encoding encs[3] = {CT_DIGEST_HEX, CT_DIGEST_BASE32, CT_DIGEST_BASE64URL};
+
+    for (size_t i = 0; i < sizeof(d); i++) {
+        (&d[0][0])[i] = rng_byte();
+    }
+    for (size_t e = 0; e < 3; e++) {
+        size_t len = N * ct_digest_encoded_len(encs[e]);
+        ref_encode(encs[e], &d[0][0], N, text);
+        for (size_t pos = 0; pos < len; pos++) {
+            char keep = text[pos];
+            for (int c = 0; c < 256; c++) {
+                text[pos] = (char)c;
+                ct_digest_simd_set_isa(CT_DIGEST_ISA_SCALAR);
+                int want = ct_digest_decode(encs[e], text, N, &ref[0][0]);
+                ct_digest_simd_set_isa(isa);
+                int rc = ct_digest_decode(encs[e], text, N, &got[0][0]);
+                assert(rc == want);
+                assert(rc != 0 || memcmp(got, ref, sizeof(got)) == 0);
+            }
+            text[pos] = keep;
+        }
+    }
+}
+
+static void check_compare_bulk(void) {
+    enum { N = 37 };
+    uint8_t hay[N][CT_RESUME_HASH_LEN];
+    uint8_t needle[CT_RESUME_HASH_LEN];
+    uint8_t eq[N];
+
+    for (size_t i = 0; i < sizeof(hay); i++) {
+        (&hay[0][0])[i] = rng_byte();
+    }
+    memcpy(hay[30], hay[11], CT_RESUME_HASH_LEN);
+    for (size_t p = 0; p < N; p++) {
+        memcpy(needle, hay[p], CT_RESUME_HASH_LEN);
+        size_t first = p == 30 ? 11 : p;
+        assert(ct_digest_find(needle, &hay[0][0], N) == first);
+        assert(ct_digest_find(needle, &hay[0][0], p) == (first < p ? first : p));
+        ct_digest_equal_batch(needle, &hay[0][0], N, eq);
+        for (size_t i = 0; i < N; i++) {
+            int same = memcmp(hay[i], needle, CT_RESUME_HASH_LEN) == 0;
+            assert(eq[i] == same);
+        }
+    }
+    // A single flipped bit in any byte is a miss.
+    for (size_t b = 0; b < CT_RESUME_HASH_LEN * 8; b++) {
+        memcpy(needle, hay[N - 1], CT_RESUME_HASH_LEN);
+        needle[b / 8] ^= (uint8_t)(1u << (b % 8));
+        assert(ct_digest_find(needle, &hay[0][0], N) == N);
+        ct_digest_equal_batch(needle, &hay[0][0], N, eq);
+        assert(eq[N - 1] == 0);
+    }
+}
+
+int main(void) {
+    // Run everything on each kernel level this CPU has.
+    for (int isa = CT_DIGEST_ISA_SCALAR; isa <= CT_DIGEST_ISA_NEON; isa++) {
+        if (ct_digest_simd_set_isa(isa) != isa) {
+            continue;
+        }
+        check_roundtrip(CT_DIGEST_HEX, hex);
+        check_roundtrip(CT_DIGEST_BASE32, base32);
+        check_roundtrip(CT_DIGEST_BASE64URL, base64url);
+        check_decode_rules();
+        check_compare();
+        check_truncate();
+        check_bulk();
+        check_decode_matches_scalar(isa);
+        check_compare_bulk();
+        printf("test_digest_codec: isa %d ok\n", isa);
+    }
+    ct_digest_simd_set_isa(-1);
+    printf("test_digest_codec: ok\n");
+    return 0;
+}
@@ -30,11 +30,17 @@ static void check_streaming(void) {
 
     ct_resume_hash_ctx *ctx = ct_resume_hash_new();
     assert(ctx);
-    assert(ct_resume_hash_update(ctx, (const uint8_t *)chunk1, strlen(chunk1)) == 0);
-    assert(ct_resume_hash_update(ctx, (const uint8_t *)chunk2, strlen(chunk2)) == 0);
+    // Empty chunk before any buffer exists is a no-op.
+    int rc = ct_resume_hash_update(ctx, (const uint8_t *)chunk1, 0);
+    assert(rc == 0);
+    rc = ct_resume_hash_update(ctx, (const uint8_t *)chunk1, strlen(chunk1));
+    assert(rc == 0);
+    rc = ct_resume_hash_update(ctx, (const uint8_t *)chunk2, strlen(chunk2));
+    assert(rc == 0);
 
     uint8_t out[CT_RESUME_HASH_LEN];
-    assert(ct_resume_hash_final(ctx, out) == 0);
+    rc = ct_resume_hash_final(ctx, out);
+    assert(rc == 0);
     ct_resume_hash_free(ctx);
     assert(memcmp(out, expected, CT_RESUME_HASH_LEN) == 0);
 }
@@ -18,8 +18,8 @@ int main(void) {
     check_case("Hello   World", "hello world");
     check_case(" Hello\tWorld\n", "hello world");
     check_case("Mixed\tCASE\r\n", "mixed case");
-    check_case("CTRL\x01\x02abc", "ctrlabc");
-    check_case("UTF8 áéí", "utf8 ??");
+    check_case("CTRL\x01\x02" "abc", "ctrlabc");
+    check_case("UTF8 áéí", "utf8 ??????");
 
     printf("test_normalize: ok\n");
     return 0;
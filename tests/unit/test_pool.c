@@ -0,0 +1,125 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ct_resume_hash.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t hello_world[CT_RESUME_HASH_LEN] = {
+    0xb9, 0x4d, 0x27, 0xb9, 0x93, 0x4d, 0x3e, 0x08,
+    0xa5, 0x2e, 0x52, 0xd7, 0xda, 0x7d, 0xab, 0xfa,
+    0xc4, 0x84, 0xef, 0xe3, 0x7a, 0x53, 0x80, 0xee,
+    0x90, 0x88, 0xf7, 0xac, 0xe2, 0xef, 0xcd, 0xe9};
+
+static void check_inline_fast_path(void) {
+    const char *input = "Hello\nWorld";
+    ct_resume_hash_pool *pool = ct_resume_hash_pool_new(1, 64);
+    assert(pool);
+
+    uint8_t out[CT_RESUME_HASH_LEN];
+    int rc = ct_resume_hash_pool_submit(pool, (const uint8_t *)input, strlen(input), 7, out);
+    assert(rc == 1);
+    assert(memcmp(out, hello_world, CT_RESUME_HASH_LEN) == 0);
+
+    // Without an inline buffer the result still arrives as a completion.
+    rc = ct_resume_hash_pool_submit(pool, (const uint8_t *)input, strlen(input), 8, NULL);
+    assert(rc == 0);
+    ct_resume_hash_completion c;
+    size_t n = ct_resume_hash_pool_wait(pool, &c, 1, 1000);
+    assert(n == 1);
+    assert(c.tag == 8 && c.rc == 0);
+    assert(memcmp(c.digest, hello_world, CT_RESUME_HASH_LEN) == 0);
+    n = ct_resume_hash_pool_poll(pool, &c, 1);
+    assert(n == 0);
+
+    ct_resume_hash_pool_free(pool);
+}
+
+static void check_workers(void) {
+    enum { JOBS = 64, LEN = 4096 };
+    ct_resume_hash_pool *pool = ct_resume_hash_pool_new(4, 0);
+    assert(pool);
+    assert(ct_resume_hash_pool_fd(pool) >= 0);
+
+    uint8_t *input = (uint8_t *)malloc(LEN);
+    assert(input);
+    uint8_t expected[JOBS][CT_RESUME_HASH_LEN];
+    for (uint64_t i = 0; i < JOBS; i++) {
+        memset(input, 'a' + (int)(i % 26), LEN);
+        input[0] = (uint8_t)i;
+        int rc = ct_resume_hash_once(input, LEN, expected[i]);
+        assert(rc == 0);
+        rc = ct_resume_hash_pool_submit(pool, input, LEN, i, NULL);
+        assert(rc == 0);
+    }
+    // Submission copied the input; clobbering it must not affect results.
+    memset(input, 0, LEN);
+    free(input);
+
+    int seen[JOBS] = {0};
+    size_t got = 0;
+    while (got < JOBS) {
+        ct_resume_hash_completion batch[16];
+        size_t n = ct_resume_hash_pool_wait(pool, batch, 16, 5000);
+        assert(n > 0);
+        for (size_t j = 0; j < n; j++) {
+            assert(batch[j].tag < JOBS && !seen[batch[j].tag]);
+            assert(batch[j].rc == 0);
+            assert(memcmp(batch[j].digest, expected[batch[j].tag], CT_RESUME_HASH_LEN) == 0);
+            seen[batch[j].tag] = 1;
+        }
+        got += n;
+    }
+
+    ct_resume_hash_completion c;
+    size_t n = ct_resume_hash_pool_wait(pool, &c, 1, 0);
+    assert(n == 0);
+    ct_resume_hash_pool_free(pool);
+}
+
+enum { WAITERS = 2, PER_WAITER = 32 };
+
+static void *waiter_main(void *arg) {
+    ct_resume_hash_pool *pool = (ct_resume_hash_pool *)arg;
+    for (int i = 0; i < PER_WAITER; i++) {
+        // Another waiter may drain the completion this one was woken for;
+        // an unbounded wait must still only return with a result.
+        ct_resume_hash_completion c;
+        size_t n = ct_resume_hash_pool_wait(pool, &c, 1, -1);
+        assert(n == 1 && c.rc == 0);
+    }
+    return NULL;
+}
+
+static void check_concurrent_waiters(void) {
+    ct_resume_hash_pool *pool = ct_resume_hash_pool_new(2, 0);
+    assert(pool);
+
+    pthread_t waiters[WAITERS];
+    for (int w = 0; w < WAITERS; w++) {
+        int rc = pthread_create(&waiters[w], NULL, waiter_main, pool);
+        assert(rc == 0);
+    }
+    const char *input = "Hello\nWorld";
+    for (uint64_t i = 0; i < WAITERS * PER_WAITER; i++) {
+        int rc = ct_resume_hash_pool_submit(pool, (const uint8_t *)input, strlen(input), i, NULL);
+        assert(rc == 0);
+    }
+    for (int w = 0; w < WAITERS; w++) {
+        int rc = pthread_join(waiters[w], NULL);
+        assert(rc == 0);
+    }
+    ct_resume_hash_pool_free(pool);
+}
+
+int main(void) {
+    assert(ct_resume_hash_pool_new(0, 0) == NULL);
+    check_inline_fast_path();
+    check_workers();
+    check_concurrent_waiters();
+    printf("test_pool: ok\n");
+    return 0;
+}